@@ -0,0 +1,321 @@
+// Library scan benchmark.
+//
+// Generates a synthetic steamapps/workshop/content/431960 tree under a temporary
+// directory and times WallpaperManager::refreshWallpapers() against it, first with
+// no library index (cold) and then from a fresh manager that loads the index the
+// cold run wrote (warm, like an application restart). Runs on the offscreen QPA
+// and keeps its config in the temporary directory, so the real setup is untouched.
+//
+//   bench_scan [--items N] [--sequential] [--eager-properties] [--watch] [--keep]
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QColor>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTextStream>
+#include <sys/resource.h>
+#include "core/ConfigManager.h"
+#include "core/WallpaperManager.h"
+
+namespace {
+
+const QStringList WALLPAPER_TYPES = {"scene", "scene", "scene", "video", "web", "application"};
+const QStringList TAGS = {"Abstract", "Anime", "Cartoon", "CGI", "Cyberpunk", "Fantasy", "Game",
+                          "Girls", "Landscape", "Medieval", "Memes", "MMD", "Music", "Nature",
+                          "Pixel art", "Relaxing", "Retro", "Sci-Fi", "Sports", "Technology",
+                          "Television", "Vehicle", "Unspecified", "Everyone", "Questionable"};
+const QStringList PREVIEW_NAMES = {"preview.jpg", "preview.gif", "preview.png", "thumb.jpg", "cover.jpg"};
+
+template <typename T>
+const T& pick(QRandomGenerator& random, const QList<T>& values)
+{
+    return values.at(random.bounded(int(values.size())));
+}
+
+qint64 peakRssKiB()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return usage.ru_maxrss; // KiB on Linux
+}
+
+QJsonObject makeProperty(QRandomGenerator& random, int order)
+{
+    QJsonObject property;
+    property["order"] = order;
+
+    switch (random.bounded(5)) {
+    case 0:
+        property["type"] = "color";
+        property["text"] = "ui_browse_properties_scheme_color";
+        property["value"] = QString("%1 %2 %3").arg(random.generateDouble(), 0, 'f', 5)
+                                .arg(random.generateDouble(), 0, 'f', 5)
+                                .arg(random.generateDouble(), 0, 'f', 5);
+        break;
+    case 1:
+        property["type"] = "slider";
+        property["text"] = QString("Intensity %1").arg(order);
+        property["min"] = 0;
+        property["max"] = 100;
+        property["precision"] = 2;
+        property["value"] = random.bounded(100);
+        break;
+    case 2: {
+        property["type"] = "combo";
+        property["text"] = QString("Mode %1").arg(order);
+        QJsonArray options;
+        for (int i = 0; i < 4; ++i) {
+            options.append(QJsonObject{{"label", QString("Option %1").arg(i)}, {"value", QString::number(i)}});
+        }
+        property["options"] = options;
+        property["value"] = "0";
+        break;
+    }
+    case 3:
+        property["type"] = "bool";
+        property["text"] = QString("Enable effect %1").arg(order);
+        property["value"] = random.bounded(2) == 1;
+        // Conditional visibility, as many scene wallpapers use
+        property["condition"] = QString("prop%1.value == true").arg(qMax(0, order - 1));
+        break;
+    default:
+        property["type"] = "textinput";
+        property["text"] = QString("Label %1").arg(order);
+        property["value"] = QString("Text value %1").arg(random.generate());
+        break;
+    }
+    return property;
+}
+
+QByteArray makeProjectJson(QRandomGenerator& random, const QString& workshopId)
+{
+    QJsonObject root;
+    root["title"] = QString("Synthetic wallpaper %1").arg(workshopId);
+    root["description"] = QString("Generated by bench_scan. ").repeated(1 + random.bounded(20));
+    root["type"] = pick(random, WALLPAPER_TYPES);
+    root["file"] = root["type"].toString() == "video" ? "video.mp4" : "scene.json";
+    root["preview"] = "preview.jpg";
+    root["workshopid"] = workshopId;
+    root["contentrating"] = "Everyone";
+    root["version"] = 0;
+
+    QJsonArray tags;
+    const int tagCount = 1 + random.bounded(4);
+    for (int i = 0; i < tagCount; ++i) {
+        tags.append(pick(random, TAGS));
+    }
+    root["tags"] = tags;
+
+    QJsonObject properties;
+    const int propertyCount = random.bounded(24);
+    for (int i = 0; i < propertyCount; ++i) {
+        properties[QString("prop%1").arg(i)] = makeProperty(random, i);
+    }
+    // Scheme color is present on almost every workshop item
+    properties["schemecolor"] = QJsonObject{{"order", 0}, {"text", "ui_browse_properties_scheme_color"},
+                                            {"type", "color"}, {"value", "0.7 0.2 0.3"}};
+
+    QJsonObject general;
+    general["properties"] = properties;
+    general["supportsaudioprocessing"] = random.bounded(2) == 1;
+    root["general"] = general;
+
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+bool writeFile(const QString& path, const QByteArray& data)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+bool generateWorkshop(const QString& workshopPath, int items, QTextStream& out)
+{
+    QRandomGenerator random(431960); // Fixed seed, every run scans the same tree
+    QDir workshopDir(workshopPath);
+
+    // A handful of distinct preview images, copied as bytes so generation stays fast
+    QList<QByteArray> previews;
+    for (int i = 0; i < 8; ++i) {
+        QImage image(256, 144, QImage::Format_RGB32);
+        image.fill(QColor::fromHsv((i * 45) % 360, 160, 200));
+        QString previewPath = workshopDir.filePath(QString(".preview%1.png").arg(i));
+        if (!image.save(previewPath, "PNG")) {
+            out << "Failed to write preview image " << previewPath << Qt::endl;
+            return false;
+        }
+        QFile previewFile(previewPath);
+        if (!previewFile.open(QIODevice::ReadOnly)) {
+            out << "Failed to read back preview image " << previewPath << Qt::endl;
+            return false;
+        }
+        previews.append(previewFile.readAll());
+        previewFile.close();
+        QFile::remove(previewPath);
+    }
+
+    for (int i = 0; i < items; ++i) {
+        const QString workshopId = QString::number(1000000000ULL + quint64(i) * 7919);
+        const QString itemPath = workshopDir.filePath(workshopId);
+        if (!workshopDir.mkpath(workshopId)) {
+            out << "Failed to create " << itemPath << Qt::endl;
+            return false;
+        }
+        QDir itemDir(itemPath);
+
+        if (!writeFile(itemDir.filePath("project.json"), makeProjectJson(random, workshopId))) {
+            out << "Failed to write project.json in " << itemPath << Qt::endl;
+            return false;
+        }
+
+        writeFile(itemDir.filePath(pick(random, PREVIEW_NAMES)), pick(random, previews));
+
+        // Payload and nested material files so directories are not trivially small
+        writeFile(itemDir.filePath("scene.pkg"), QByteArray(4096 + random.bounded(65536), 'x'));
+        if (random.bounded(3) == 0) {
+            itemDir.mkpath("materials/effects");
+            writeFile(itemDir.filePath("materials/effects/shine.json"), QByteArray(512, 'm'));
+            writeFile(itemDir.filePath("materials/background.tex"), QByteArray(8192, 't'));
+        }
+    }
+
+    // Some directories in a real workshop have no project.json yet
+    workshopDir.mkpath("999999999");
+    return true;
+}
+
+qint64 timeRefresh(WallpaperManager& manager)
+{
+    QEventLoop loop;
+    bool finished = false;
+    QObject::connect(&manager, &WallpaperManager::refreshFinished, &loop, [&]() {
+        finished = true;
+        loop.quit();
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    manager.refreshWallpapers();
+    if (!finished) {
+        loop.exec(); // Parallel scans finish from the event loop
+    }
+    return timer.elapsed();
+}
+
+void report(QTextStream& out, const char* label, int items, qint64 msecs)
+{
+    const double seconds = qMax<qint64>(msecs, 1) / 1000.0;
+    out << QString("%1  %2 wallpapers in %3 ms  %4 items/s  peak RSS %5 MiB")
+               .arg(label, -5)
+               .arg(items)
+               .arg(msecs, 6)
+               .arg(items / seconds, 10, 'f', 0)
+               .arg(peakRssKiB() / 1024.0, 0, 'f', 1)
+        << Qt::endl;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    // Headless by default; an explicit QT_QPA_PLATFORM still wins
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    // ConfigManager and the library index live under the config location, which has
+    // to point into the temporary tree before anything resolves it
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        QTextStream(stderr) << "Failed to create a temporary directory" << Qt::endl;
+        return 1;
+    }
+    qputenv("XDG_CONFIG_HOME", QDir(tempDir.path()).filePath("config").toLocal8Bit());
+
+    QApplication app(argc, argv);
+    app.setApplicationName("bench_scan");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times library scans against a synthetic workshop tree");
+    parser.addHelpOption();
+    QCommandLineOption itemsOption("items", "Number of workshop items to generate.", "count", "2000");
+    QCommandLineOption sequentialOption("sequential", "Use the single-threaded scan.");
+    QCommandLineOption eagerOption("eager-properties", "Keep properties in the scan results (lazy mode off).");
+    QCommandLineOption watchOption("watch", "Keep library watching on; it adds inotify setup to each refresh.");
+    QCommandLineOption keepOption("keep", "Do not delete the generated tree.");
+    parser.addOptions({itemsOption, sequentialOption, eagerOption, watchOption, keepOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+
+    bool itemsOk = false;
+    const int items = parser.value(itemsOption).toInt(&itemsOk);
+    if (!itemsOk || items <= 0) {
+        out << "--items must be a positive number" << Qt::endl;
+        return 1;
+    }
+
+    tempDir.setAutoRemove(!parser.isSet(keepOption));
+    const QString steamPath = QDir(tempDir.path()).filePath("steam");
+    const QString workshopPath = QDir(steamPath).filePath("steamapps/workshop/content/431960");
+    QDir().mkpath(workshopPath);
+
+    QElapsedTimer generateTimer;
+    generateTimer.start();
+    if (!generateWorkshop(workshopPath, items, out)) {
+        return 1;
+    }
+    out << "Generated " << items << " items in " << generateTimer.elapsed() << " ms under "
+        << tempDir.path() << Qt::endl;
+
+    ConfigManager& config = ConfigManager::instance();
+    config.setSteamPath(steamPath);
+    config.setSteamLibraryPaths(QStringList());
+    config.setParallelScanEnabled(!parser.isSet(sequentialOption));
+    config.setLazyPropertiesEnabled(!parser.isSet(eagerOption));
+    config.setLibraryWatchEnabled(parser.isSet(watchOption));
+
+    out << "Mode: " << (parser.isSet(sequentialOption) ? "sequential" : "parallel")
+        << ", properties " << (parser.isSet(eagerOption) ? "eager" : "lazy")
+        << ", watch " << (parser.isSet(watchOption) ? "on" : "off") << Qt::endl;
+
+    int found = 0;
+    {
+        WallpaperManager cold;
+        const qint64 msecs = timeRefresh(cold);
+        found = cold.wallpaperCount();
+        report(out, "cold", found, msecs);
+    }
+
+    {
+        // A new manager loads the index from disk, the way the application does on start
+        WallpaperManager warm;
+        const qint64 msecs = timeRefresh(warm);
+        report(out, "warm", warm.wallpaperCount(), msecs);
+    }
+
+    if (found != items) {
+        out << "Expected " << items << " wallpapers, the scan found " << found << Qt::endl;
+        return 1;
+    }
+
+    if (parser.isSet(keepOption)) {
+        out << "Kept generated tree in " << tempDir.path() << Qt::endl;
+    }
+    return 0;
+}
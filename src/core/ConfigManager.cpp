@@ -621,6 +621,118 @@ void ConfigManager::setShowTrayWarning(bool show)
     m_settings->sync();
 }
 
+// Library scanning
+bool ConfigManager::parallelScanEnabled() const
+{
+    return m_settings->value("library/parallel_scan", true).toBool();
+}
+
+void ConfigManager::setParallelScanEnabled(bool enabled)
+{
+    m_settings->setValue("library/parallel_scan", enabled);
+    m_settings->sync();
+}
+
+bool ConfigManager::libraryWatchEnabled() const
+{
+    return m_settings->value("library/watch", true).toBool();
+}
+
+void ConfigManager::setLibraryWatchEnabled(bool enabled)
+{
+    m_settings->setValue("library/watch", enabled);
+    m_settings->sync();
+}
+
+bool ConfigManager::lazyPropertiesEnabled() const
+{
+    return m_settings->value("library/lazy_properties", true).toBool();
+}
+
+void ConfigManager::setLazyPropertiesEnabled(bool enabled)
+{
+    m_settings->setValue("library/lazy_properties", enabled);
+    m_settings->sync();
+}
+
+// Thumbnail cache
+int ConfigManager::thumbnailCacheSizeMB() const
+{
+    return m_settings->value("thumbnails/disk_cache_mb", 256).toInt();
+}
+
+void ConfigManager::setThumbnailCacheSizeMB(int megabytes)
+{
+    m_settings->setValue("thumbnails/disk_cache_mb", megabytes);
+    m_settings->sync();
+}
+
+int ConfigManager::thumbnailMemoryCacheMB() const
+{
+    return m_settings->value("thumbnails/memory_cache_mb", 64).toInt();
+}
+
+void ConfigManager::setThumbnailMemoryCacheMB(int megabytes)
+{
+    m_settings->setValue("thumbnails/memory_cache_mb", megabytes);
+    m_settings->sync();
+}
+
+int ConfigManager::thumbnailAnimationCacheMB() const
+{
+    return m_settings->value("thumbnails/animation_cache_mb", 128).toInt();
+}
+
+void ConfigManager::setThumbnailAnimationCacheMB(int megabytes)
+{
+    m_settings->setValue("thumbnails/animation_cache_mb", megabytes);
+    m_settings->sync();
+}
+
+bool ConfigManager::transcodeAnimatedPreviews() const
+{
+    return m_settings->value("thumbnails/transcode_animations", true).toBool();
+}
+
+void ConfigManager::setTranscodeAnimatedPreviews(bool enabled)
+{
+    m_settings->setValue("thumbnails/transcode_animations", enabled);
+    m_settings->sync();
+}
+
+int ConfigManager::animationDiskCacheMB() const
+{
+    return m_settings->value("thumbnails/animation_disk_cache_mb", 512).toInt();
+}
+
+void ConfigManager::setAnimationDiskCacheMB(int megabytes)
+{
+    m_settings->setValue("thumbnails/animation_disk_cache_mb", megabytes);
+    m_settings->sync();
+}
+
+bool ConfigManager::virtualizedGridEnabled() const
+{
+    return m_settings->value("ui/virtualized_grid", false).toBool();
+}
+
+void ConfigManager::setVirtualizedGridEnabled(bool enabled)
+{
+    m_settings->setValue("ui/virtualized_grid", enabled);
+    m_settings->sync();
+}
+
+int ConfigManager::maxPreviewAnimations() const
+{
+    return m_settings->value("ui/max_preview_animations", 16).toInt();
+}
+
+void ConfigManager::setMaxPreviewAnimations(int count)
+{
+    m_settings->setValue("ui/max_preview_animations", count);
+    m_settings->sync();
+}
+
 // WNEL Addon settings
 bool ConfigManager::isWNELAddonEnabled() const
 {
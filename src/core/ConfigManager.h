@@ -133,6 +133,32 @@ public:
     bool showTrayWarning() const;
     void setShowTrayWarning(bool show);
 
+    // Library scanning
+    bool parallelScanEnabled() const;
+    void setParallelScanEnabled(bool enabled);
+    bool libraryWatchEnabled() const;
+    void setLibraryWatchEnabled(bool enabled);
+    bool lazyPropertiesEnabled() const;
+    void setLazyPropertiesEnabled(bool enabled);
+
+    // Thumbnail cache
+    int thumbnailCacheSizeMB() const;
+    void setThumbnailCacheSizeMB(int megabytes);
+    int thumbnailMemoryCacheMB() const;
+    void setThumbnailMemoryCacheMB(int megabytes);
+    int thumbnailAnimationCacheMB() const;
+    void setThumbnailAnimationCacheMB(int megabytes);
+    bool transcodeAnimatedPreviews() const;
+    void setTranscodeAnimatedPreviews(bool enabled);
+    int animationDiskCacheMB() const;
+    void setAnimationDiskCacheMB(int megabytes);
+
+    // Wallpaper grid
+    bool virtualizedGridEnabled() const;
+    void setVirtualizedGridEnabled(bool enabled);
+    int maxPreviewAnimations() const;
+    void setMaxPreviewAnimations(int count);
+
     // Steam API settings
     QString steamApiKey() const;
     void setSteamApiKey(const QString& apiKey);
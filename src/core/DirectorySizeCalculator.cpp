@@ -0,0 +1,95 @@
+#include "DirectorySizeCalculator.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(directorySize, "app.directorySize")
+
+DirectorySizeCalculator::DirectorySizeCalculator(QObject* parent)
+    : QObject(parent)
+    , m_generation(0)
+{
+    m_pool.setMaxThreadCount(MAX_THREADS);
+    m_pool.setObjectName("DirectorySizePool");
+}
+
+DirectorySizeCalculator::~DirectorySizeCalculator()
+{
+    // Workers post their results back to this object, so they must be gone before it is
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+void DirectorySizeCalculator::enqueue(const QString& dirPath, qint64 directoryModified)
+{
+    if (dirPath.isEmpty()) {
+        return;
+    }
+    auto pending = m_pending.find(dirPath);
+    if (pending != m_pending.end()) {
+        pending.value() = directoryModified;  // Picked up in onJobFinished()
+        return;
+    }
+    m_pending.insert(dirPath, directoryModified);
+
+    const int generation = m_generation.loadRelaxed();
+    m_pool.start([this, dirPath, directoryModified, generation]() {
+        if (m_generation.loadRelaxed() != generation) {
+            return;
+        }
+        qint64 size = directorySize(dirPath, &m_generation, generation);
+        QMetaObject::invokeMethod(this, [this, dirPath, directoryModified, size, generation]() {
+            onJobFinished(dirPath, directoryModified, size, generation);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void DirectorySizeCalculator::cancelAll()
+{
+    m_generation.fetchAndAddRelaxed(1);
+    m_pool.clear();
+    m_pending.clear();
+}
+
+void DirectorySizeCalculator::onJobFinished(const QString& dirPath, qint64 directoryModified,
+                                            qint64 size, int generation)
+{
+    if (generation != m_generation.loadRelaxed()) {
+        return; // Cancelled while walking; the result may be partial
+    }
+    const qint64 requestedModified = m_pending.take(dirPath);
+
+    if (size < 0) {
+        qCDebug(directorySize) << "Could not measure" << dirPath;
+    } else {
+        emit sizeCalculated(dirPath, directoryModified, size);
+    }
+
+    // The directory changed while it was queued or walked; measure it again for the newer mtime
+    if (requestedModified != directoryModified) {
+        enqueue(dirPath, requestedModified);
+    }
+}
+
+qint64 DirectorySizeCalculator::directorySize(const QString& dirPath, const QAtomicInt* cancelGeneration,
+                                              int generation)
+{
+    if (!QFileInfo(dirPath).isDir()) {
+        return -1;
+    }
+
+    qint64 total = 0;
+    QDirIterator it(dirPath, QDir::Files | QDir::Hidden | QDir::System | QDir::NoSymLinks,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        total += it.fileInfo().size();
+
+        if (cancelGeneration && cancelGeneration->loadRelaxed() != generation) {
+            return -1;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,46 @@
+#ifndef DIRECTORYSIZECALCULATOR_H
+#define DIRECTORYSIZECALCULATOR_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QThreadPool>
+#include <QAtomicInt>
+
+// Measures the on-disk size of wallpaper directories on a small private thread pool.
+// Each request is tagged with the directory mtime it was made for so the receiver can
+// drop results that no longer describe the directory. The pool is separate from the
+// global one used by the library scan, so sizing never holds up a refresh.
+class DirectorySizeCalculator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DirectorySizeCalculator(QObject* parent = nullptr);
+    ~DirectorySizeCalculator();
+
+    // Queues a directory. One already waiting or being measured is not queued twice; if
+    // it was requested for another mtime it is measured again once the current walk ends
+    void enqueue(const QString& dirPath, qint64 directoryModified);
+    // Drops queued work and tells running walks to stop early
+    void cancelAll();
+    int pendingCount() const { return m_pending.size(); }
+
+    // Recursive size of all regular files below dirPath; symlinks are not followed
+    static qint64 directorySize(const QString& dirPath, const QAtomicInt* cancelGeneration = nullptr,
+                                int generation = 0);
+
+signals:
+    void sizeCalculated(const QString& dirPath, qint64 directoryModified, qint64 size);
+
+private:
+    void onJobFinished(const QString& dirPath, qint64 directoryModified, qint64 size, int generation);
+
+    QThreadPool m_pool;
+    QHash<QString, qint64> m_pending;  // Directory -> newest mtime it was requested for
+    QAtomicInt m_generation;  // Bumped by cancelAll(); workers stop when it moves on
+
+    static constexpr int MAX_THREADS = 2;  // Disk bound, more threads only add seeks
+};
+
+#endif // DIRECTORYSIZECALCULATOR_H
@@ -0,0 +1,459 @@
+#include "ProjectJsonReader.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QVarLengthArray>
+#include <cstring>
+#include <limits>
+
+namespace {
+bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+}
+
+ProjectJsonReader::ProjectJsonReader(bool withProperties)
+    : m_withProperties(withProperties)
+    , m_begin(nullptr)
+    , m_pos(nullptr)
+    , m_end(nullptr)
+    , m_propertiesSkipped(false)
+{
+}
+
+bool ProjectJsonReader::readFile(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_error = file.errorString();
+        return false;
+    }
+
+    // Mapped pages that are only skipped over never have to be copied into the heap
+    const qint64 size = file.size();
+    if (size > 0 && size <= std::numeric_limits<int>::max()) {
+        if (const uchar* data = file.map(0, size)) {
+            bool ok = read(QByteArray::fromRawData(reinterpret_cast<const char*>(data), int(size)));
+            file.unmap(const_cast<uchar*>(data));
+            return ok;
+        }
+    }
+
+    return read(file.readAll());
+}
+
+bool ProjectJsonReader::read(const QByteArray& data)
+{
+    m_error.clear();
+    m_title.clear();
+    m_type.clear();
+    m_description.clear();
+    m_tags.clear();
+    m_generalProperties = QJsonObject();
+    m_rootProperties = QJsonObject();
+    m_propertiesSkipped = false;
+
+    m_begin = data.constData();
+    m_pos = m_begin;
+    m_end = m_begin + data.size();
+
+    // Same as QJsonDocument, a UTF-8 byte order mark is allowed
+    if (m_end - m_pos >= 3 && std::memcmp(m_pos, "\xEF\xBB\xBF", 3) == 0) {
+        m_pos += 3;
+    }
+
+    bool ok = parseDocument();
+
+    // Nothing may keep pointing into data once it is gone
+    m_begin = m_pos = m_end = nullptr;
+    return ok;
+}
+
+QJsonObject ProjectJsonReader::properties() const
+{
+    QJsonObject properties = m_generalProperties;
+    for (auto it = m_rootProperties.constBegin(); it != m_rootProperties.constEnd(); ++it) {
+        properties[it.key()] = it.value();
+    }
+    return properties;
+}
+
+bool ProjectJsonReader::parseDocument()
+{
+    skipWhitespace();
+    if (!expect('{')) {
+        return fail("document is not an object");
+    }
+
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == '}') {
+        ++m_pos;
+    } else {
+        while (true) {
+            QString key;
+            skipWhitespace();
+            if (!parseString(&key, MAX_TEXT_BYTES)) {
+                return false;
+            }
+            skipWhitespace();
+            if (!expect(':')) {
+                return fail("missing ':' after key");
+            }
+            skipWhitespace();
+
+            // A later duplicate overrides an earlier one, as with QJsonObject
+            bool isString = m_pos < m_end && *m_pos == '"';
+            bool ok = true;
+            if (key == QLatin1String("title")) {
+                m_title.clear();
+                ok = isString ? parseString(&m_title, MAX_TEXT_BYTES) : skipValue();
+            } else if (key == QLatin1String("type")) {
+                m_type.clear();
+                ok = isString ? parseString(&m_type, MAX_TEXT_BYTES) : skipValue();
+            } else if (key == QLatin1String("description")) {
+                m_description.clear();
+                ok = isString ? parseString(&m_description, MAX_TEXT_BYTES) : skipValue();
+            } else if (key == QLatin1String("tags")) {
+                ok = parseTags();
+            } else if (key == QLatin1String("general")) {
+                ok = parseGeneral();
+            } else if (key == QLatin1String("properties")) {
+                ok = captureProperties(&m_rootProperties);
+            } else {
+                ok = skipValue();
+            }
+            if (!ok) {
+                return false;
+            }
+
+            skipWhitespace();
+            if (m_pos < m_end && *m_pos == ',') {
+                ++m_pos;
+                continue;
+            }
+            if (!expect('}')) {
+                return fail("expected ',' or '}' in object");
+            }
+            break;
+        }
+    }
+
+    skipWhitespace();
+    if (m_pos != m_end) {
+        return fail("garbage after document");
+    }
+    return true;
+}
+
+bool ProjectJsonReader::parseGeneral()
+{
+    if (m_pos >= m_end || *m_pos != '{') {
+        return skipValue();
+    }
+    ++m_pos;
+
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == '}') {
+        ++m_pos;
+        return true;
+    }
+
+    while (true) {
+        QString key;
+        skipWhitespace();
+        if (!parseString(&key, MAX_TEXT_BYTES)) {
+            return false;
+        }
+        skipWhitespace();
+        if (!expect(':')) {
+            return fail("missing ':' after key");
+        }
+        skipWhitespace();
+
+        bool ok = key == QLatin1String("properties") ? captureProperties(&m_generalProperties) : skipValue();
+        if (!ok) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_pos < m_end && *m_pos == ',') {
+            ++m_pos;
+            continue;
+        }
+        if (!expect('}')) {
+            return fail("expected ',' or '}' in object");
+        }
+        return true;
+    }
+}
+
+bool ProjectJsonReader::parseTags()
+{
+    m_tags.clear();
+    if (m_pos >= m_end || *m_pos != '[') {
+        return skipValue();
+    }
+    ++m_pos;
+
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == ']') {
+        ++m_pos;
+        return true;
+    }
+
+    while (true) {
+        skipWhitespace();
+        bool keep = m_tags.size() < MAX_TAGS;
+        if (m_pos < m_end && *m_pos == '"' && keep) {
+            QString tag;
+            if (!parseString(&tag, MAX_TEXT_BYTES)) {
+                return false;
+            }
+            m_tags.append(tag);
+        } else {
+            if (!skipValue()) {
+                return false;
+            }
+            if (keep) {
+                m_tags.append(QString()); // Non-string tags read as empty, like QJsonValue::toString()
+            }
+        }
+
+        skipWhitespace();
+        if (m_pos < m_end && *m_pos == ',') {
+            ++m_pos;
+            continue;
+        }
+        if (!expect(']')) {
+            return fail("expected ',' or ']' in array");
+        }
+        return true;
+    }
+}
+
+bool ProjectJsonReader::captureProperties(QJsonObject* out)
+{
+    *out = QJsonObject();
+    const char* start = m_pos;
+    if (!skipValue()) {
+        return false;
+    }
+    if (!m_withProperties || *start != '{') {
+        return true;
+    }
+
+    const qint64 length = m_pos - start;
+    if (length > MAX_PROPERTIES_BYTES) {
+        m_propertiesSkipped = true;
+        return true;
+    }
+
+    // Only this span is materialised, the rest of the document never is
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromRawData(start, int(length)), &error);
+    if (error.error != QJsonParseError::NoError) {
+        m_pos = start + error.offset;
+        return fail(error.errorString());
+    }
+    *out = doc.object();
+    return true;
+}
+
+bool ProjectJsonReader::parseString(QString* out, int maxBytes)
+{
+    if (!expect('"')) {
+        return fail("expected string");
+    }
+
+    // Literal runs are decoded in one go, escapes one at a time; past maxBytes the
+    // rest of the string is only skipped
+    const char* runStart = m_pos;
+    int decodedBytes = 0;
+    auto flushRun = [&](const char* runEnd) {
+        int length = int(runEnd - runStart);
+        int room = qMax(0, maxBytes - decodedBytes);
+        if (out && room > 0) {
+            int take = qMin(length, room);
+            // Never cut a multi-byte UTF-8 sequence in half
+            while (take < length && take > 0 && (uchar(runStart[take]) & 0xC0) == 0x80) {
+                --take;
+            }
+            out->append(QString::fromUtf8(runStart, take));
+        }
+        decodedBytes += length;
+    };
+
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if (c == '"') {
+            flushRun(m_pos);
+            ++m_pos;
+            return true;
+        }
+        if (c != '\\') {
+            ++m_pos;
+            continue;
+        }
+
+        flushRun(m_pos);
+        ++m_pos;
+        if (m_pos >= m_end) {
+            break;
+        }
+
+        QChar decoded;
+        switch (*m_pos) {
+        case '"': decoded = QLatin1Char('"'); break;
+        case '\\': decoded = QLatin1Char('\\'); break;
+        case '/': decoded = QLatin1Char('/'); break;
+        case 'b': decoded = QLatin1Char('\b'); break;
+        case 'f': decoded = QLatin1Char('\f'); break;
+        case 'n': decoded = QLatin1Char('\n'); break;
+        case 'r': decoded = QLatin1Char('\r'); break;
+        case 't': decoded = QLatin1Char('\t'); break;
+        case 'u': {
+            if (m_end - m_pos < 5) {
+                return fail("truncated \\u escape");
+            }
+            ushort code = 0;
+            for (int i = 1; i <= 4; ++i) {
+                int digit = hexValue(m_pos[i]);
+                if (digit < 0) {
+                    return fail("invalid \\u escape");
+                }
+                code = ushort(code * 16 + digit);
+            }
+            m_pos += 4;
+            // Surrogate pairs arrive as two escapes and end up as two UTF-16 units
+            decoded = QChar(code);
+            break;
+        }
+        default:
+            return fail("invalid escape sequence");
+        }
+
+        ++m_pos;
+        if (out && decodedBytes < maxBytes) {
+            out->append(decoded);
+        }
+        decodedBytes++;
+        runStart = m_pos;
+    }
+
+    return fail("unterminated string");
+}
+
+bool ProjectJsonReader::skipValue()
+{
+    skipWhitespace();
+    if (m_pos >= m_end) {
+        return fail("unexpected end of document");
+    }
+
+    if (*m_pos == '"') {
+        return skipString();
+    }
+    if (*m_pos != '{' && *m_pos != '[') {
+        return skipLiteral();
+    }
+
+    // Containers are skipped iteratively, a deeply nested file cannot exhaust the stack
+    QVarLengthArray<char, 64> closers;
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if (c == '"') {
+            if (!skipString()) {
+                return false;
+            }
+            continue;
+        }
+        if (c == '{' || c == '[') {
+            if (closers.size() >= MAX_DEPTH) {
+                return fail("document nested too deeply");
+            }
+            closers.append(c == '{' ? '}' : ']');
+        } else if (c == '}' || c == ']') {
+            if (closers.isEmpty() || closers.last() != c) {
+                return fail("mismatched bracket");
+            }
+            closers.removeLast();
+            if (closers.isEmpty()) {
+                ++m_pos;
+                return true;
+            }
+        }
+        ++m_pos;
+    }
+
+    return fail("unterminated object or array");
+}
+
+bool ProjectJsonReader::skipString()
+{
+    ++m_pos; // Opening quote
+    while (m_pos < m_end) {
+        const char* quote = static_cast<const char*>(std::memchr(m_pos, '"', size_t(m_end - m_pos)));
+        if (!quote) {
+            break;
+        }
+
+        // The quote is escaped when an odd number of backslashes precede it
+        int backslashes = 0;
+        for (const char* p = quote - 1; p >= m_pos && *p == '\\'; --p) {
+            ++backslashes;
+        }
+        m_pos = quote + 1;
+        if (backslashes % 2 == 0) {
+            return true;
+        }
+    }
+
+    m_pos = m_end;
+    return fail("unterminated string");
+}
+
+bool ProjectJsonReader::skipLiteral()
+{
+    // Numbers, true, false and null; the exact spelling is not checked
+    const char* start = m_pos;
+    while (m_pos < m_end && !isWhitespace(*m_pos) && *m_pos != ',' && *m_pos != '}' && *m_pos != ']') {
+        ++m_pos;
+    }
+    if (m_pos == start) {
+        return fail("expected value");
+    }
+    return true;
+}
+
+bool ProjectJsonReader::expect(char c)
+{
+    if (m_pos < m_end && *m_pos == c) {
+        ++m_pos;
+        return true;
+    }
+    return false;
+}
+
+void ProjectJsonReader::skipWhitespace()
+{
+    while (m_pos < m_end && isWhitespace(*m_pos)) {
+        ++m_pos;
+    }
+}
+
+bool ProjectJsonReader::fail(const QString& message)
+{
+    // Keep the first error, later ones are only fallout from it
+    if (m_error.isEmpty()) {
+        m_error = QString("%1 at offset %2").arg(message).arg(m_pos ? qint64(m_pos - m_begin) : -1);
+    }
+    return false;
+}
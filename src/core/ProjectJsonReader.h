@@ -0,0 +1,68 @@
+#ifndef PROJECTJSONREADER_H
+#define PROJECTJSONREADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QJsonObject>
+
+// Pulls the fields the library needs out of a project.json without building a DOM.
+//
+// The document is walked once; title, type, description and tags are decoded, the
+// general.properties and root properties objects are handed to QJsonDocument only
+// when asked for, and everything else (scene data, preset lists, ...) is skipped by
+// matching brackets. Files are read through a memory mapping and every decoded value
+// has a size cap, so a huge or hostile file costs a linear scan rather than its size
+// in heap. Skipped subtrees are only checked for balanced structure.
+class ProjectJsonReader
+{
+public:
+    explicit ProjectJsonReader(bool withProperties = true);
+
+    bool readFile(const QString& filePath);
+    bool read(const QByteArray& data);
+    QString errorString() const { return m_error; }
+
+    QString title() const { return m_title; }
+    QString type() const { return m_type; }
+    QString description() const { return m_description; }
+    QStringList tags() const { return m_tags; }
+    // general.properties merged with root-level properties, root wins on conflicts
+    QJsonObject properties() const;
+    // The properties objects were larger than MAX_PROPERTIES_BYTES and were left out
+    bool propertiesSkipped() const { return m_propertiesSkipped; }
+
+    static constexpr int MAX_TEXT_BYTES = 64 * 1024;            // Per string value
+    static constexpr int MAX_TAGS = 256;
+    static constexpr int MAX_PROPERTIES_BYTES = 4 * 1024 * 1024;
+    static constexpr int MAX_DEPTH = 512;
+
+private:
+    bool parseDocument();
+    bool parseGeneral();
+    bool parseTags();
+    bool parseString(QString* out, int maxBytes);
+    bool captureProperties(QJsonObject* out);
+    bool skipValue();
+    bool skipString();
+    bool skipLiteral();
+    bool expect(char c);
+    void skipWhitespace();
+    bool fail(const QString& message);
+
+    bool m_withProperties;
+    const char* m_begin;
+    const char* m_pos;
+    const char* m_end;
+    QString m_error;
+
+    QString m_title;
+    QString m_type;
+    QString m_description;
+    QStringList m_tags;
+    QJsonObject m_generalProperties;
+    QJsonObject m_rootProperties;
+    bool m_propertiesSkipped;
+};
+
+#endif // PROJECTJSONREADER_H
@@ -0,0 +1,407 @@
+#include "WallpaperCatalog.h"
+#include <QSaveFile>
+#include <QCborValue>
+#include <QCborMap>
+#include <QtEndian>
+#include <QLoggingCategory>
+#include <limits>
+#include <cstring>
+
+Q_LOGGING_CATEGORY(wallpaperCatalog, "app.wallpaperCatalog")
+
+namespace {
+constexpr char CATALOG_MAGIC[4] = { 'W', 'P', 'E', 'C' };
+
+// Bump whenever the record layout or the meaning of a field changes; older files are discarded
+constexpr quint32 CATALOG_VERSION = 3;
+
+// Header: magic, version, recordCount, stringCount, stringTableOffset,
+//         recordTableOffset, tagTableOffset, tagCount, blobOffset
+constexpr qint64 HEADER_SIZE = 36;
+
+// Record: 64-bit stat/date fields first, then string ids, then the tag and blob spans
+enum RecordInt64 {
+    ProjectSizeField,
+    ProjectModifiedField,
+    DirectoryModifiedField,
+    FileSizeField,
+    SizeModifiedField,
+    CreatedField,
+    UpdatedField,
+    PlaceholderColorField,
+    Int64FieldCount
+};
+
+enum RecordString {
+    PathField,
+    IdField,
+    NameField,
+    AuthorField,
+    AuthorIdField,
+    DescriptionField,
+    TypeField,
+    PreviewPathField,
+    ProjectPathField,
+    StringFieldCount
+};
+
+constexpr qint64 RECORD_STRINGS_OFFSET = Int64FieldCount * 8;
+constexpr qint64 RECORD_TAGS_OFFSET = RECORD_STRINGS_OFFSET + StringFieldCount * 4;
+constexpr qint64 RECORD_BLOB_OFFSET = RECORD_TAGS_OFFSET + 8;
+constexpr qint64 RECORD_SIZE = RECORD_BLOB_OFFSET + 8;
+
+constexpr qint64 INVALID_DATE = std::numeric_limits<qint64>::min();
+
+void appendUInt32(QByteArray& out, quint32 value)
+{
+    char buffer[4];
+    qToLittleEndian(value, buffer);
+    out.append(buffer, sizeof(buffer));
+}
+
+void appendInt64(QByteArray& out, qint64 value)
+{
+    char buffer[8];
+    qToLittleEndian(value, buffer);
+    out.append(buffer, sizeof(buffer));
+}
+
+qint64 dateToMSecs(const QDateTime& date)
+{
+    return date.isValid() ? date.toMSecsSinceEpoch() : INVALID_DATE;
+}
+
+QDateTime dateFromMSecs(qint64 msecs)
+{
+    return msecs == INVALID_DATE ? QDateTime() : QDateTime::fromMSecsSinceEpoch(msecs);
+}
+
+// Hands out one id per distinct string so repeated values are stored once
+class StringInterner
+{
+public:
+    StringInterner() { intern(QString()); }  // Id 0 is always the empty string
+
+    quint32 intern(const QString& value)
+    {
+        auto it = m_ids.constFind(value);
+        if (it != m_ids.constEnd()) {
+            return it.value();
+        }
+        quint32 id = static_cast<quint32>(m_strings.size());
+        m_ids.insert(value, id);
+        m_strings.append(value.toUtf8());
+        return id;
+    }
+
+    const QList<QByteArray>& strings() const { return m_strings; }
+
+private:
+    QHash<QString, quint32> m_ids;
+    QList<QByteArray> m_strings;
+};
+}
+
+WallpaperCatalog::WallpaperCatalog()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_recordCount(0)
+    , m_stringCount(0)
+    , m_stringTableOffset(0)
+    , m_recordTableOffset(0)
+    , m_tagTableOffset(0)
+    , m_tagCount(0)
+    , m_blobOffset(0)
+{
+}
+
+WallpaperCatalog::~WallpaperCatalog()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+    }
+}
+
+bool WallpaperCatalog::open(const QString& filePath)
+{
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qCWarning(wallpaperCatalog) << "Failed to open wallpaper catalog:" << filePath;
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size < HEADER_SIZE) {
+        qCWarning(wallpaperCatalog) << "Wallpaper catalog is truncated:" << filePath;
+        m_file.close();
+        return false;
+    }
+
+    // The file stays open for as long as the mapping is in use; closing it would unmap
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        qCWarning(wallpaperCatalog) << "Failed to map wallpaper catalog:" << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    if (!validate()) {
+        m_file.unmap(const_cast<uchar*>(m_data));
+        m_data = nullptr;
+        m_file.close();
+        return false;
+    }
+
+    qCDebug(wallpaperCatalog) << "Mapped wallpaper catalog with" << m_recordCount << "records and"
+                              << m_stringCount << "strings," << m_size << "bytes";
+    return true;
+}
+
+bool WallpaperCatalog::validate()
+{
+    if (std::memcmp(m_data, CATALOG_MAGIC, sizeof(CATALOG_MAGIC)) != 0) {
+        qCWarning(wallpaperCatalog) << "Not a wallpaper catalog:" << m_file.fileName();
+        return false;
+    }
+
+    quint32 version = readUInt32(4);
+    if (version != CATALOG_VERSION) {
+        qCInfo(wallpaperCatalog) << "Discarding wallpaper catalog with version" << version;
+        return false;
+    }
+
+    m_recordCount = readUInt32(8);
+    m_stringCount = readUInt32(12);
+    m_stringTableOffset = readUInt32(16);
+    m_recordTableOffset = readUInt32(20);
+    m_tagTableOffset = readUInt32(24);
+    m_tagCount = readUInt32(28);
+    m_blobOffset = readUInt32(32);
+
+    // Every section has to fit inside the file; individual strings and blobs are
+    // bounds-checked again when they are read
+    bool sectionsFit = m_stringTableOffset + qint64(m_stringCount) * 8 <= m_size
+        && m_recordTableOffset + qint64(m_recordCount) * RECORD_SIZE <= m_size
+        && m_tagTableOffset + qint64(m_tagCount) * 4 <= m_size
+        && m_blobOffset <= m_size
+        && m_stringCount > 0;
+
+    if (!sectionsFit) {
+        qCWarning(wallpaperCatalog) << "Wallpaper catalog has an invalid layout:" << m_file.fileName();
+        return false;
+    }
+
+    return true;
+}
+
+quint32 WallpaperCatalog::readUInt32(qint64 offset) const
+{
+    return qFromLittleEndian<quint32>(m_data + offset);
+}
+
+qint64 WallpaperCatalog::readInt64(qint64 offset) const
+{
+    return qFromLittleEndian<qint64>(m_data + offset);
+}
+
+QString WallpaperCatalog::string(quint32 id) const
+{
+    if (id == 0 || id >= m_stringCount) {
+        return QString();
+    }
+
+    qint64 entryOffset = m_stringTableOffset + qint64(id) * 8;
+    quint32 offset = readUInt32(entryOffset);
+    quint32 length = readUInt32(entryOffset + 4);
+    if (qint64(offset) + length > m_size) {
+        return QString();
+    }
+
+    return QString::fromUtf8(reinterpret_cast<const char*>(m_data + offset), length);
+}
+
+WallpaperIndexEntry WallpaperCatalog::entry(int index) const
+{
+    WallpaperIndexEntry entry;
+    if (!m_data || index < 0 || index >= count()) {
+        return entry;
+    }
+
+    const qint64 record = m_recordTableOffset + qint64(index) * RECORD_SIZE;
+    auto int64Field = [this, record](RecordInt64 field) {
+        return readInt64(record + field * 8);
+    };
+    auto stringField = [this, record](RecordString field) {
+        return string(readUInt32(record + RECORD_STRINGS_OFFSET + field * 4));
+    };
+
+    entry.path = stringField(PathField);
+    entry.projectSize = int64Field(ProjectSizeField);
+    entry.projectModified = int64Field(ProjectModifiedField);
+    entry.directoryModified = int64Field(DirectoryModifiedField);
+
+    WallpaperInfo& info = entry.info;
+    info.id = stringField(IdField);
+    info.name = stringField(NameField);
+    info.author = stringField(AuthorField);
+    info.authorId = stringField(AuthorIdField);
+    info.description = stringField(DescriptionField);
+    info.type = stringField(TypeField);
+    info.path = entry.path;
+    info.previewPath = stringField(PreviewPathField);
+    info.projectPath = stringField(ProjectPathField);
+    info.fileSize = int64Field(FileSizeField);
+    entry.sizeModified = int64Field(SizeModifiedField);
+    info.created = dateFromMSecs(int64Field(CreatedField));
+    info.updated = dateFromMSecs(int64Field(UpdatedField));
+    info.placeholderColor = static_cast<quint32>(int64Field(PlaceholderColorField));
+
+    quint32 tagFirst = readUInt32(record + RECORD_TAGS_OFFSET);
+    quint32 tagCount = readUInt32(record + RECORD_TAGS_OFFSET + 4);
+    if (qint64(tagFirst) + tagCount <= m_tagCount) {
+        info.tags.reserve(tagCount);
+        for (quint32 i = 0; i < tagCount; ++i) {
+            info.tags.append(string(readUInt32(m_tagTableOffset + qint64(tagFirst + i) * 4)));
+        }
+    }
+
+    // Properties are only needed by the properties panel; keep the CBOR bytes in
+    // place and let the caller decode them when they are actually asked for
+    quint32 blobOffset = readUInt32(record + RECORD_BLOB_OFFSET);
+    quint32 blobLength = readUInt32(record + RECORD_BLOB_OFFSET + 4);
+    if (blobLength > 0 && m_blobOffset + qint64(blobOffset) + blobLength <= m_size) {
+        entry.propertiesBlob = QByteArray::fromRawData(
+            reinterpret_cast<const char*>(m_data + m_blobOffset + blobOffset), blobLength);
+    }
+
+    return entry;
+}
+
+bool WallpaperCatalog::write(const QString& filePath, const QList<WallpaperIndexEntry>& entries)
+{
+    StringInterner strings;
+    QByteArray records;
+    QByteArray tags;
+    QByteArray blobs;
+    quint32 tagCount = 0;
+
+    records.reserve(entries.size() * RECORD_SIZE);
+
+    for (const WallpaperIndexEntry& entry : entries) {
+        const WallpaperInfo& info = entry.info;
+
+        appendInt64(records, entry.projectSize);
+        appendInt64(records, entry.projectModified);
+        appendInt64(records, entry.directoryModified);
+        appendInt64(records, info.fileSize);
+        appendInt64(records, entry.sizeModified);
+        appendInt64(records, dateToMSecs(info.created));
+        appendInt64(records, dateToMSecs(info.updated));
+        appendInt64(records, info.placeholderColor);
+
+        appendUInt32(records, strings.intern(entry.path));
+        appendUInt32(records, strings.intern(info.id));
+        appendUInt32(records, strings.intern(info.name));
+        appendUInt32(records, strings.intern(info.author));
+        appendUInt32(records, strings.intern(info.authorId));
+        appendUInt32(records, strings.intern(info.description));
+        appendUInt32(records, strings.intern(info.type));
+        appendUInt32(records, strings.intern(info.previewPath));
+        appendUInt32(records, strings.intern(info.projectPath));
+
+        appendUInt32(records, tagCount);
+        appendUInt32(records, static_cast<quint32>(info.tags.size()));
+        for (const QString& tag : info.tags) {
+            appendUInt32(tags, strings.intern(tag));
+            ++tagCount;
+        }
+
+        // Entries that came from a previous catalog carry their blob untouched,
+        // freshly parsed ones still have the decoded object
+        QByteArray blob = entry.propertiesBlob.isEmpty() && !info.properties.isEmpty()
+            ? encodeProperties(info.properties)
+            : entry.propertiesBlob;
+        appendUInt32(records, static_cast<quint32>(blobs.size()));
+        appendUInt32(records, static_cast<quint32>(blob.size()));
+        blobs.append(blob);
+    }
+
+    const QList<QByteArray>& stringData = strings.strings();
+    const qint64 stringTableOffset = HEADER_SIZE;
+    qint64 offset = stringTableOffset + qint64(stringData.size()) * 8;
+
+    QByteArray stringTable;
+    QByteArray stringBytes;
+    stringTable.reserve(stringData.size() * 8);
+    for (const QByteArray& value : stringData) {
+        appendUInt32(stringTable, static_cast<quint32>(offset + stringBytes.size()));
+        appendUInt32(stringTable, static_cast<quint32>(value.size()));
+        stringBytes.append(value);
+    }
+
+    const qint64 recordTableOffset = offset + stringBytes.size();
+    const qint64 tagTableOffset = recordTableOffset + records.size();
+    const qint64 blobOffset = tagTableOffset + tags.size();
+    if (blobOffset + blobs.size() > std::numeric_limits<quint32>::max()) {
+        qCWarning(wallpaperCatalog) << "Wallpaper catalog would exceed 4 GiB, not writing it";
+        return false;
+    }
+
+    QByteArray header;
+    header.append(CATALOG_MAGIC, sizeof(CATALOG_MAGIC));
+    appendUInt32(header, CATALOG_VERSION);
+    appendUInt32(header, static_cast<quint32>(entries.size()));
+    appendUInt32(header, static_cast<quint32>(stringData.size()));
+    appendUInt32(header, static_cast<quint32>(stringTableOffset));
+    appendUInt32(header, static_cast<quint32>(recordTableOffset));
+    appendUInt32(header, static_cast<quint32>(tagTableOffset));
+    appendUInt32(header, tagCount);
+    appendUInt32(header, static_cast<quint32>(blobOffset));
+
+    // QSaveFile renames over the old catalog, so a mapping of the previous file stays valid
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(wallpaperCatalog) << "Failed to open wallpaper catalog for writing:" << file.fileName();
+        return false;
+    }
+
+    file.write(header);
+    file.write(stringTable);
+    file.write(stringBytes);
+    file.write(records);
+    file.write(tags);
+    file.write(blobs);
+
+    if (!file.commit()) {
+        qCWarning(wallpaperCatalog) << "Failed to write wallpaper catalog:" << file.errorString();
+        return false;
+    }
+
+    qCDebug(wallpaperCatalog) << "Wrote wallpaper catalog with" << entries.size() << "records and"
+                              << stringData.size() << "strings," << blobOffset + blobs.size() << "bytes";
+    return true;
+}
+
+QByteArray WallpaperCatalog::encodeProperties(const QJsonObject& properties)
+{
+    if (properties.isEmpty()) {
+        return QByteArray();
+    }
+    return QCborValue(QCborMap::fromJsonObject(properties)).toCbor();
+}
+
+QJsonObject WallpaperCatalog::decodeProperties(const QByteArray& blob)
+{
+    if (blob.isEmpty()) {
+        return QJsonObject();
+    }
+
+    QCborParserError error;
+    QCborValue value = QCborValue::fromCbor(blob, &error);
+    if (error.error != QCborError::NoError) {
+        qCWarning(wallpaperCatalog) << "Failed to decode properties blob:" << error.errorString();
+        return QJsonObject();
+    }
+
+    return value.toMap().toJsonObject();
+}
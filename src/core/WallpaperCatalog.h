@@ -0,0 +1,59 @@
+#ifndef WALLPAPERCATALOG_H
+#define WALLPAPERCATALOG_H
+
+#include <QString>
+#include <QList>
+#include <QFile>
+#include <QByteArray>
+#include <QJsonObject>
+#include "WallpaperIndex.h"
+
+// Versioned binary catalog of scanned wallpapers, read through a memory mapping.
+//
+// Layout (little-endian, offsets from the start of the file):
+//   header        magic "WPEC", version, record/string counts and section offsets
+//   string table  one {offset, length} pair per interned UTF-8 string
+//   string data   each distinct string stored once (types, tags, authors are shared)
+//   record table  fixed-size records of stat data, string ids, tag span and properties span
+//   tag table     flat array of string ids referenced by the records
+//   blob area     CBOR-encoded properties, only decoded when someone asks for them
+class WallpaperCatalog
+{
+public:
+    WallpaperCatalog();
+    ~WallpaperCatalog();
+
+    bool open(const QString& filePath);
+    bool isOpen() const { return m_data != nullptr; }
+    int count() const { return static_cast<int>(m_recordCount); }
+
+    // Decodes one record; the properties stay as a raw blob that points into the mapping
+    WallpaperIndexEntry entry(int index) const;
+
+    static bool write(const QString& filePath, const QList<WallpaperIndexEntry>& entries);
+
+    static QByteArray encodeProperties(const QJsonObject& properties);
+    static QJsonObject decodeProperties(const QByteArray& blob);
+
+private:
+    WallpaperCatalog(const WallpaperCatalog&) = delete;
+    WallpaperCatalog& operator=(const WallpaperCatalog&) = delete;
+
+    bool validate();
+    QString string(quint32 id) const;
+    quint32 readUInt32(qint64 offset) const;
+    qint64 readInt64(qint64 offset) const;
+
+    QFile m_file;
+    const uchar* m_data;
+    qint64 m_size;
+    quint32 m_recordCount;
+    quint32 m_stringCount;
+    quint32 m_stringTableOffset;
+    quint32 m_recordTableOffset;
+    quint32 m_tagTableOffset;
+    quint32 m_tagCount;
+    quint32 m_blobOffset;
+};
+
+#endif // WALLPAPERCATALOG_H
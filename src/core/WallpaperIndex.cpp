@@ -0,0 +1,123 @@
+#include "WallpaperIndex.h"
+#include "WallpaperCatalog.h"
+#include "ConfigManager.h"
+#include <QDir>
+#include <QFile>
+#include <QLoggingCategory>
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(wallpaperIndex, "app.wallpaperIndex")
+
+bool WallpaperIndexEntry::matches(const QFileInfo& projectInfo, const QFileInfo& dirInfo) const
+{
+    return projectSize == projectInfo.size()
+        && projectModified == projectInfo.lastModified().toMSecsSinceEpoch()
+        && directoryModified == dirInfo.lastModified().toMSecsSinceEpoch();
+}
+
+void WallpaperIndexEntry::setStatData(const QFileInfo& projectInfo, const QFileInfo& dirInfo)
+{
+    projectSize = projectInfo.size();
+    projectModified = projectInfo.lastModified().toMSecsSinceEpoch();
+    directoryModified = dirInfo.lastModified().toMSecsSinceEpoch();
+}
+
+QJsonObject WallpaperIndexEntry::properties() const
+{
+    if (!info.properties.isEmpty() || propertiesBlob.isEmpty()) {
+        return info.properties;
+    }
+    return WallpaperCatalog::decodeProperties(propertiesBlob);
+}
+
+WallpaperIndex::WallpaperIndex()
+    : m_loaded(false)
+{
+}
+
+QString WallpaperIndex::filePath() const
+{
+    return QDir(ConfigManager::instance().configDir()).filePath("library_index.bin");
+}
+
+bool WallpaperIndex::load()
+{
+    m_loaded = true;
+    m_entries.clear();
+    removeLegacyIndex();
+
+    if (!QFile::exists(filePath())) {
+        qCDebug(wallpaperIndex) << "No library index yet, first scan will be cold";
+        return false;
+    }
+
+    QSharedPointer<WallpaperCatalog> catalog(new WallpaperCatalog);
+    if (!catalog->open(filePath())) {
+        return false;
+    }
+
+    m_entries.reserve(catalog->count());
+    for (int i = 0; i < catalog->count(); ++i) {
+        WallpaperIndexEntry entry = catalog->entry(i);
+        if (!entry.path.isEmpty() && entry.isValid()) {
+            m_entries.insert(entry.path, entry);
+        }
+    }
+
+    m_catalog = catalog;
+    qCDebug(wallpaperIndex) << "Loaded library index with" << m_entries.size() << "entries";
+    return true;
+}
+
+bool WallpaperIndex::save() const
+{
+    // Sorted so that an unchanged library always produces the same file
+    QList<WallpaperIndexEntry> entries = m_entries.values();
+    std::sort(entries.begin(), entries.end(), [](const WallpaperIndexEntry& a, const WallpaperIndexEntry& b) {
+        return a.path < b.path;
+    });
+
+    QDir().mkpath(ConfigManager::instance().configDir());
+
+    if (!WallpaperCatalog::write(filePath(), entries)) {
+        qCWarning(wallpaperIndex) << "Failed to save library index:" << filePath();
+        return false;
+    }
+
+    qCDebug(wallpaperIndex) << "Saved library index with" << m_entries.size() << "entries";
+    return true;
+}
+
+void WallpaperIndex::setEntries(const QList<WallpaperIndexEntry>& entries)
+{
+    m_entries.clear();
+    m_entries.reserve(entries.size());
+    for (const WallpaperIndexEntry& entry : entries) {
+        if (entry.isValid()) {
+            m_entries.insert(entry.path, entry);
+        }
+    }
+}
+
+void WallpaperIndex::insertEntry(const WallpaperIndexEntry& entry)
+{
+    if (entry.isValid()) {
+        m_entries.insert(entry.path, entry);
+    } else {
+        m_entries.remove(entry.path);
+    }
+}
+
+void WallpaperIndex::removeEntry(const QString& path)
+{
+    m_entries.remove(path);
+}
+
+void WallpaperIndex::removeLegacyIndex() const
+{
+    // Older builds kept the index as JSON next to the config
+    QString legacyPath = QDir(ConfigManager::instance().configDir()).filePath("library_index.json");
+    if (QFile::exists(legacyPath) && QFile::remove(legacyPath)) {
+        qCInfo(wallpaperIndex) << "Removed legacy JSON library index";
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef WALLPAPERINDEX_H
+#define WALLPAPERINDEX_H
+
+#include <QString>
+#include <QHash>
+#include <QList>
+#include <QJsonObject>
+#include <QFileInfo>
+#include <QByteArray>
+#include <QSharedPointer>
+#include "WallpaperInfo.h"
+
+class WallpaperCatalog;
+
+// One scanned wallpaper directory together with the stat data it was parsed from
+struct WallpaperIndexEntry {
+    QString path;                  // Wallpaper directory
+    qint64 projectSize = -1;       // project.json size in bytes
+    qint64 projectModified = 0;    // project.json mtime (msecs since epoch)
+    qint64 directoryModified = 0;  // Directory mtime, changes when preview files come and go
+    qint64 sizeModified = 0;       // Directory mtime info.fileSize was measured at, 0 if never
+    WallpaperInfo info;            // Parsed metadata including the resolved preview path
+    QByteArray propertiesBlob;     // Encoded properties when info.properties has not been decoded
+
+    bool isValid() const { return !info.id.isEmpty(); }
+    // info.fileSize was measured for the directory as it is now
+    bool hasCurrentSize() const { return sizeModified != 0 && sizeModified == directoryModified; }
+
+    // info.properties if present, otherwise decoded from the catalog blob
+    QJsonObject properties() const;
+
+    // True when the cached entry still describes the files on disk
+    bool matches(const QFileInfo& projectInfo, const QFileInfo& dirInfo) const;
+    void setStatData(const QFileInfo& projectInfo, const QFileInfo& dirInfo);
+    bool hasSameStatData(const WallpaperIndexEntry& other) const {
+        return projectSize == other.projectSize
+            && projectModified == other.projectModified
+            && directoryModified == other.directoryModified;
+    }
+};
+
+// Persistent library index stored under ConfigManager::configDir() as a WallpaperCatalog.
+// Lets a refresh skip re-parsing project.json files whose stat data is unchanged.
+// The catalog loaded at startup stays mapped for the lifetime of the index because
+// entries read from it reference their properties blobs in place.
+class WallpaperIndex
+{
+public:
+    using EntryMap = QHash<QString, WallpaperIndexEntry>;  // Keyed by wallpaper directory
+
+    WallpaperIndex();
+
+    bool load();
+    bool save() const;
+    bool isLoaded() const { return m_loaded; }
+
+    const EntryMap& entries() const { return m_entries; }
+    void setEntries(const QList<WallpaperIndexEntry>& entries);
+    void insertEntry(const WallpaperIndexEntry& entry);
+    void removeEntry(const QString& path);
+    int size() const { return m_entries.size(); }
+
+    QString filePath() const;
+
+private:
+    void removeLegacyIndex() const;
+
+    QSharedPointer<WallpaperCatalog> m_catalog;
+    EntryMap m_entries;
+    bool m_loaded;
+};
+
+#endif // WALLPAPERINDEX_H
@@ -0,0 +1,82 @@
+#ifndef WALLPAPERINFO_H
+#define WALLPAPERINFO_H
+
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QFlags>
+#include <QSharedPointer>
+
+struct WallpaperInfo {
+    // Groups of fields reported by WallpaperManager::wallpaperUpdated
+    enum Field {
+        NoFields          = 0x000,
+        NameField         = 0x001,
+        AuthorField       = 0x002,  // author and authorId
+        DescriptionField  = 0x004,
+        TypeField         = 0x008,
+        PreviewField      = 0x010,
+        TagsField         = 0x020,
+        DatesField        = 0x040,  // created and updated
+        FileSizeField     = 0x080,
+        LocationField     = 0x100,  // path and projectPath
+        PropertiesField   = 0x200,
+        AllFields         = 0x3FF
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+    
+
+    QString id;
+    QString name;
+    QString author;
+    QString authorId;
+    QString description;
+    QString type;
+    QString path;
+    QString previewPath;
+    QString projectPath;
+    QDateTime created;
+    QDateTime updated;
+    qint64 fileSize = 0;
+    quint32 placeholderColor = 0;  // Dominant preview colour as 0xAARRGGBB, 0 if unknown
+    QStringList tags;
+    QJsonObject properties;  // Properties from project.json
+    
+    WallpaperInfo() = default;
+    
+    bool operator==(const WallpaperInfo& other) const {
+        return id == other.id;
+    }
+    
+    // Which field groups differ from other; properties are compared as stored,
+    // so an info whose properties have not been decoded differs from one that has
+    Fields changedFields(const WallpaperInfo& other) const {
+        Fields changed;
+        if (name != other.name) changed |= NameField;
+        if (author != other.author || authorId != other.authorId) changed |= AuthorField;
+        if (description != other.description) changed |= DescriptionField;
+        if (type != other.type) changed |= TypeField;
+        if (previewPath != other.previewPath || placeholderColor != other.placeholderColor) changed |= PreviewField;
+        if (tags != other.tags) changed |= TagsField;
+        if (created != other.created || updated != other.updated) changed |= DatesField;
+        if (fileSize != other.fileSize) changed |= FileSizeField;
+        if (path != other.path || projectPath != other.projectPath) changed |= LocationField;
+        if (properties != other.properties) changed |= PropertiesField;
+        return changed;
+    }
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(WallpaperInfo::Fields)
+
+// Immutable, shared record as handed out by WallpaperManager. Copying a handle is a
+// reference count bump, so lists of them can be filtered and paged without copying
+// descriptions, tags or property trees.
+using WallpaperInfoPtr = QSharedPointer<const WallpaperInfo>;
+
+inline WallpaperInfoPtr makeWallpaperInfoPtr(const WallpaperInfo& info)
+{
+    return QSharedPointer<WallpaperInfo>::create(info);
+}
+
+#endif // WALLPAPERINFO_H
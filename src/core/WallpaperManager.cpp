@@ -1,7 +1,12 @@
 #include "WallpaperManager.h"
 #include "ConfigManager.h"
+#include "DirectorySizeCalculator.h"
+#include "ProjectJsonReader.h"
 #include <QDir>
+#include <QDirIterator>
 #include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -10,6 +15,9 @@
 #include <QLoggingCategory>
 #include <QProcessEnvironment>
 #include <QTimer>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <algorithm>
 #include <signal.h>
 #include <cerrno>
 
@@ -17,13 +25,47 @@ Q_LOGGING_CATEGORY(wallpaperManager, "app.wallpaperManager")
 
 WallpaperManager::WallpaperManager(QObject* parent)
     : QObject(parent)
+    , m_propertiesCache(PROPERTIES_CACHE_SIZE)
+    , m_scanWithProperties(false)
     , m_wallpaperProcess(nullptr)
     , m_refreshing(false)
+    , m_resetPending(true)
+    , m_scanWatcher(new QFutureWatcher<WallpaperIndexEntry>(this))
+    , m_scanTotal(0)
+    , m_sizeCalculator(new DirectorySizeCalculator(this))
+    , m_sizeSaveTimer(new QTimer(this))
+    , m_libraryWatcher(new QFileSystemWatcher(this))
+    , m_watchDebounceTimer(new QTimer(this))
 {
+    connect(m_scanWatcher, &QFutureWatcher<WallpaperIndexEntry>::finished,
+            this, &WallpaperManager::onParallelScanFinished);
+    
+    m_watchDebounceTimer->setSingleShot(true);
+    m_watchDebounceTimer->setInterval(WATCH_DEBOUNCE_MS);
+    connect(m_watchDebounceTimer, &QTimer::timeout, this, &WallpaperManager::processWatchedChanges);
+    connect(m_libraryWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &WallpaperManager::onWatchedDirectoryChanged);
+    
+    m_sizeSaveTimer->setSingleShot(true);
+    m_sizeSaveTimer->setInterval(SIZE_SAVE_DELAY_MS);
+    connect(m_sizeSaveTimer, &QTimer::timeout, this, [this]() { m_index.save(); });
+    connect(m_sizeCalculator, &DirectorySizeCalculator::sizeCalculated,
+            this, &WallpaperManager::onDirectorySizeCalculated);
 }
 
 WallpaperManager::~WallpaperManager()
 {
+    // Scan workers emit progress through this object, so they must be gone before it is
+    if (m_scanWatcher->isRunning()) {
+        m_scanWatcher->cancel();
+        m_scanWatcher->waitForFinished();
+    }
+    
+    m_sizeCalculator->cancelAll();
+    if (m_sizeSaveTimer->isActive()) {
+        m_index.save(); // Keep the sizes measured since the last write
+    }
+    
     stopWallpaper();
 }
 
@@ -35,17 +77,122 @@ void WallpaperManager::refreshWallpapers()
     }
     
     m_refreshing = true;
-    m_wallpapers.clear();
+    ensureIndexLoaded();
+    
+    if (ConfigManager::instance().parallelScanEnabled()) {
+        qCDebug(wallpaperManager) << "Starting parallel wallpaper refresh";
+        startParallelScan();
+        return; // finishRefresh() runs once the worker pool is done
+    }
     
     qCDebug(wallpaperManager) << "Starting wallpaper refresh";
     scanWorkshopDirectories();
     
+    finishRefresh();
+}
+
+void WallpaperManager::finishRefresh()
+{
     m_refreshing = false;
+    updateWatchedPaths();
+    queueDirectorySizes();
     emit refreshFinished();
-    emit wallpapersChanged();
+    
+    // Refreshes on top of an existing list were already published as a diff
+    if (m_resetPending) {
+        m_resetPending = false;
+        m_propertiesCache.clear();
+        emit wallpapersChanged();
+    }
 }
 
-void WallpaperManager::scanWorkshopDirectories()
+void WallpaperManager::publishCatalogDiff(const QList<WallpaperInfoPtr>& previous,
+                                          const WallpaperIndex::EntryMap& previousEntries,
+                                          const QList<WallpaperIndexEntry>& current)
+{
+    QSet<QString> previousIds;
+    previousIds.reserve(previous.size());
+    for (const WallpaperInfoPtr& wallpaper : previous) {
+        previousIds.insert(wallpaper->id);
+    }
+    
+    QSet<QString> currentIds;
+    currentIds.reserve(current.size());
+    QStringList addedIds;
+    FieldChanges updated;
+    
+    for (const WallpaperIndexEntry& entry : current) {
+        currentIds.insert(entry.info.id);
+        if (!previousIds.contains(entry.info.id)) {
+            addedIds.append(entry.info.id);
+            continue;
+        }
+        
+        // Entries reused from the index carry the same stat data and cannot have changed
+        auto before = previousEntries.constFind(entry.path);
+        if (before == previousEntries.constEnd() || before->hasSameStatData(entry)) {
+            continue;
+        }
+        
+        WallpaperInfo::Fields changed = changedFields(*before, entry);
+        if (changed) {
+            updated.append(qMakePair(entry.info.id, changed));
+        }
+    }
+    
+    QStringList removedIds;
+    for (const WallpaperInfoPtr& wallpaper : previous) {
+        if (!currentIds.contains(wallpaper->id)) {
+            removedIds.append(wallpaper->id);
+        }
+    }
+    
+    qCDebug(wallpaperManager) << "Refresh diff:" << addedIds.size() << "added,"
+                              << removedIds.size() << "removed," << updated.size() << "updated";
+    emitCatalogChanges(addedIds, removedIds, updated);
+}
+
+void WallpaperManager::emitCatalogChanges(const QStringList& addedIds, const QStringList& removedIds,
+                                          const FieldChanges& updated)
+{
+    for (const QString& id : removedIds) {
+        m_propertiesCache.remove(id);
+    }
+    for (const auto& change : updated) {
+        m_propertiesCache.remove(change.first);
+    }
+    
+    if (!removedIds.isEmpty()) {
+        emit wallpapersRemoved(removedIds);
+    }
+    if (!addedIds.isEmpty()) {
+        emit wallpapersAdded(addedIds);
+    }
+    for (const auto& change : updated) {
+        emit wallpaperUpdated(change.first, change.second);
+    }
+}
+
+WallpaperInfo::Fields WallpaperManager::changedFields(const WallpaperIndexEntry& before,
+                                                      const WallpaperIndexEntry& after)
+{
+    WallpaperInfo::Fields changed = before.info.changedFields(after.info);
+    
+    bool propertiesKept = !before.info.properties.isEmpty() || !before.propertiesBlob.isEmpty()
+        || !after.info.properties.isEmpty() || !after.propertiesBlob.isEmpty();
+    if (propertiesKept) {
+        // One side may still hold its properties as a catalog blob
+        changed.setFlag(WallpaperInfo::PropertiesField, before.properties() != after.properties());
+    } else {
+        // Lazy mode never loaded them; any change to project.json may have touched them
+        changed.setFlag(WallpaperInfo::PropertiesField,
+                        before.projectSize != after.projectSize
+                        || before.projectModified != after.projectModified);
+    }
+    return changed;
+}
+
+QStringList WallpaperManager::findWorkshopDirectories()
 {
     ConfigManager& config = ConfigManager::instance();
     QStringList libraryPaths = config.steamLibraryPaths();
@@ -68,98 +215,464 @@ void WallpaperManager::scanWorkshopDirectories()
     if (workshopPaths.isEmpty()) {
         qCWarning(wallpaperManager) << "No workshop directories found";
         emit errorOccurred("No Steam workshop directories found. Please check your Steam installation path.");
-        return;
     }
     
-    int totalDirectories = 0;
+    return workshopPaths;
+}
+
+QStringList WallpaperManager::collectWallpaperDirectories(const QStringList& workshopPaths) const
+{
+    // QDir sorts entries by name, so the scan order (and the resulting list) is stable
+    QStringList wallpaperDirs;
     for (const QString& workshopPath : workshopPaths) {
         QDir workshopDir(workshopPath);
-        totalDirectories += workshopDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot).size();
+        const QStringList dirNames = workshopDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QString& dirName : dirNames) {
+            wallpaperDirs.append(workshopDir.filePath(dirName));
+        }
     }
+    return wallpaperDirs;
+}
+
+void WallpaperManager::scanWorkshopDirectories()
+{
+    QStringList workshopPaths = findWorkshopDirectories();
+    m_workshopPaths = workshopPaths;
+    if (workshopPaths.isEmpty()) {
+        m_wallpapers.clear();
+        rebuildWallpaperSlots();
+        m_resetPending = true;
+        return;
+    }
+    
+    QStringList wallpaperDirs = collectWallpaperDirectories(workshopPaths);
+    int totalDirectories = wallpaperDirs.size();
+    const WallpaperIndex::EntryMap cache = m_index.entries();
+    m_scanParsed.storeRelaxed(0);
+    m_scanWithProperties = !ConfigManager::instance().lazyPropertiesEnabled();
+    
+    QList<WallpaperIndexEntry> results;
+    results.reserve(totalDirectories);
     
     int processed = 0;
-    for (const QString& workshopPath : workshopPaths) {
-        QDir workshopDir(workshopPath);
-        QStringList wallpaperDirs = workshopDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& fullPath : wallpaperDirs) {
+        results.append(scanWallpaperDirectory(fullPath, cache, m_scanWithProperties, &m_scanParsed));
         
-        for (const QString& dirName : wallpaperDirs) {
-            QString fullPath = workshopDir.filePath(dirName);
-            processWallpaperDirectory(fullPath);
-            
-            processed++;
-            emit refreshProgress(processed, totalDirectories);
+        processed++;
+        emit refreshProgress(processed, totalDirectories);
+    }
+    
+    applyScanResults(results);
+}
+
+void WallpaperManager::startParallelScan()
+{
+    QStringList workshopPaths = findWorkshopDirectories();
+    m_workshopPaths = workshopPaths;
+    if (workshopPaths.isEmpty()) {
+        m_wallpapers.clear();
+        rebuildWallpaperSlots();
+        m_resetPending = true;
+        finishRefresh();
+        return;
+    }
+    
+    const QStringList wallpaperDirs = collectWallpaperDirectories(workshopPaths);
+    m_scanTotal = wallpaperDirs.size();
+    m_scanProgress.storeRelaxed(0);
+    m_scanParsed.storeRelaxed(0);
+    m_scanWithProperties = !ConfigManager::instance().lazyPropertiesEnabled();
+    
+    // Report roughly every percent; signals emitted from the pool are queued to the GUI thread
+    const int progressStep = qMax(1, m_scanTotal / 100);
+    
+    qCDebug(wallpaperManager) << "Scanning" << m_scanTotal << "directories on"
+                              << QThreadPool::globalInstance()->maxThreadCount() << "threads";
+    
+    // The index map is implicitly shared, so each worker reads the same snapshot without copying
+    const WallpaperIndex::EntryMap cache = m_index.entries();
+    const bool withProperties = m_scanWithProperties;
+    m_scanWatcher->setFuture(QtConcurrent::mapped(wallpaperDirs, [this, cache, withProperties, progressStep](const QString& dirPath) {
+        WallpaperIndexEntry entry = scanWallpaperDirectory(dirPath, cache, withProperties, &m_scanParsed);
+        
+        int processed = m_scanProgress.fetchAndAddRelaxed(1) + 1;
+        if (processed == m_scanTotal || processed % progressStep == 0) {
+            emit refreshProgress(processed, m_scanTotal);
+        }
+        return entry;
+    }));
+}
+
+void WallpaperManager::onParallelScanFinished()
+{
+    // mapped() keeps results in input order, so the list never depends on thread scheduling
+    applyScanResults(m_scanWatcher->future().results());
+    finishRefresh();
+}
+
+void WallpaperManager::updateWatchedPaths()
+{
+    QStringList wanted;
+    if (ConfigManager::instance().libraryWatchEnabled() && !m_workshopPaths.isEmpty()) {
+        wanted = m_workshopPaths;
+        wanted.append(collectWallpaperDirectories(m_workshopPaths));
+    }
+    
+    // Only touch the difference so a refresh does not drop and re-add thousands of watches
+    const QStringList watched = m_libraryWatcher->directories();
+    const QSet<QString> wantedSet(wanted.cbegin(), wanted.cend());
+    const QSet<QString> watchedSet(watched.cbegin(), watched.cend());
+    
+    const QSet<QString> stale = watchedSet - wantedSet;
+    if (!stale.isEmpty()) {
+        m_libraryWatcher->removePaths(QStringList(stale.cbegin(), stale.cend()));
+    }
+    
+    const QSet<QString> missing = wantedSet - watchedSet;
+    if (!missing.isEmpty()) {
+        const QStringList failed = m_libraryWatcher->addPaths(QStringList(missing.cbegin(), missing.cend()));
+        if (!failed.isEmpty()) {
+            qCWarning(wallpaperManager) << "Could not watch" << failed.size() << "of" << wanted.size()
+                                        << "library directories, raise fs.inotify.max_user_watches"
+                                        << "to get live updates for all of them";
+        }
+    }
+    
+    qCDebug(wallpaperManager) << "Watching" << m_libraryWatcher->directories().size() << "library directories";
+}
+
+void WallpaperManager::onWatchedDirectoryChanged(const QString& path)
+{
+    m_pendingWatchPaths.insert(path);
+    m_watchDebounceTimer->start();
+}
+
+QStringList WallpaperManager::rescanWorkshopRoot(const QString& workshopPath)
+{
+    const QStringList current = collectWallpaperDirectories(QStringList{workshopPath});
+    const QSet<QString> currentSet(current.cbegin(), current.cend());
+    
+    // Directories we knew about under this root, whether or not they held a wallpaper
+    QSet<QString> known;
+    for (const QString& watchedPath : m_libraryWatcher->directories()) {
+        if (QFileInfo(watchedPath).path() == workshopPath) {
+            known.insert(watchedPath);
+        }
+    }
+    for (const WallpaperInfoPtr& wallpaper : m_wallpapers) {
+        if (QFileInfo(wallpaper->path).path() == workshopPath) {
+            known.insert(wallpaper->path);
         }
     }
     
-    qCInfo(wallpaperManager) << "Found" << m_wallpapers.size() << "wallpapers";
+    const QSet<QString> added = currentSet - known;
+    const QSet<QString> removed = known - currentSet;
+    
+    if (!added.isEmpty() && ConfigManager::instance().libraryWatchEnabled()) {
+        m_libraryWatcher->addPaths(QStringList(added.cbegin(), added.cend()));
+    }
+    
+    QStringList changed(added.cbegin(), added.cend());
+    changed.append(QStringList(removed.cbegin(), removed.cend()));
+    return changed;
+}
+
+int WallpaperManager::findWallpaperIndexByPath(const QString& path) const
+{
+    return m_wallpaperPathSlots.value(path, -1);
 }
 
-void WallpaperManager::processWallpaperDirectory(const QString& dirPath)
+void WallpaperManager::processWatchedChanges()
 {
-    QDir wallpaperDir(dirPath);
-    QString projectPath = wallpaperDir.filePath("project.json");
+    if (m_pendingWatchPaths.isEmpty()) {
+        return;
+    }
     
-    if (!QFileInfo::exists(projectPath)) {
-        return; // Skip directories without project.json
+    // A running refresh rewrites m_wallpapers wholesale; apply the deltas after it
+    if (m_refreshing) {
+        m_watchDebounceTimer->start();
+        return;
+    }
+    
+    const QSet<QString> pending = m_pendingWatchPaths;
+    m_pendingWatchPaths.clear();
+    
+    QSet<QString> itemDirs;
+    for (const QString& path : pending) {
+        if (m_workshopPaths.contains(path)) {
+            const QStringList changed = rescanWorkshopRoot(path);
+            itemDirs.unite(QSet<QString>(changed.cbegin(), changed.cend()));
+        } else {
+            itemDirs.insert(path);
+        }
     }
     
-    WallpaperInfo wallpaper = parseProjectJson(projectPath);
-    if (!wallpaper.id.isEmpty()) {
-        wallpaper.path = dirPath;
-        wallpaper.projectPath = projectPath;
-        wallpaper.previewPath = findPreviewImage(dirPath);
-        m_wallpapers.append(wallpaper);
+    QStringList sortedDirs(itemDirs.cbegin(), itemDirs.cend());
+    sortedDirs.sort();
+    
+    QStringList addedIds;
+    QStringList removedIds;
+    FieldChanges updated;
+    bool indexChanged = false;
+    
+    // Slots stay valid for the whole loop; additions and removals are merged in afterwards
+    QSet<int> removedSlots;
+    QList<WallpaperInfoPtr> addedWallpapers;  // In directory order, as sortedDirs is
+    
+    for (const QString& dirPath : sortedDirs) {
+        int existing = findWallpaperIndexByPath(dirPath);
+        
+        QAtomicInt parsed;
+        WallpaperIndexEntry entry = QFileInfo(dirPath).isDir()
+            ? scanWallpaperDirectory(dirPath, m_index.entries(),
+                                     !ConfigManager::instance().lazyPropertiesEnabled(), &parsed)
+            : WallpaperIndexEntry();
+        
+        if (!entry.isValid()) {
+            // Deleted, unsubscribed, or project.json not written yet
+            if (m_index.entries().contains(dirPath)) {
+                m_index.removeEntry(dirPath);
+                indexChanged = true;
+            }
+            if (existing >= 0) {
+                removedIds.append(m_wallpapers.at(existing)->id);
+                removedSlots.insert(existing);
+            }
+            continue;
+        }
+        
+        if (existing >= 0 && parsed.loadRelaxed() == 0) {
+            continue; // Stat data unchanged, nothing to do
+        }
+        
+        const WallpaperIndexEntry previousEntry = m_index.entries().value(dirPath);
+        m_index.insertEntry(entry);
+        indexChanged = true;
+        
+        if (existing >= 0) {
+            WallpaperInfo::Fields changed = changedFields(previousEntry, entry);
+            m_wallpapers[existing] = makeWallpaperInfoPtr(entry.info);
+            if (changed) {
+                updated.append(qMakePair(entry.info.id, changed));
+            }
+        } else {
+            addedWallpapers.append(makeWallpaperInfoPtr(entry.info));
+            addedIds.append(entry.info.id);
+        }
     }
+    
+    if (!removedSlots.isEmpty() || !addedWallpapers.isEmpty()) {
+        // Keep the scan order (sorted by directory) so a later full refresh lines up
+        QList<WallpaperInfoPtr> merged;
+        merged.reserve(m_wallpapers.size() - removedSlots.size() + addedWallpapers.size());
+        auto added = addedWallpapers.cbegin();
+        for (int i = 0; i < m_wallpapers.size(); ++i) {
+            if (removedSlots.contains(i)) {
+                continue;
+            }
+            while (added != addedWallpapers.cend() && (*added)->path < m_wallpapers.at(i)->path) {
+                merged.append(*added++);
+            }
+            merged.append(m_wallpapers.at(i));
+        }
+        while (added != addedWallpapers.cend()) {
+            merged.append(*added++);
+        }
+        m_wallpapers = merged;
+    }
+    
+    if (indexChanged) {
+        m_index.save();
+        queueDirectorySizes();
+    }
+    
+    if (addedIds.isEmpty() && removedIds.isEmpty() && updated.isEmpty()) {
+        return;
+    }
+    
+    rebuildWallpaperSlots();
+    
+    qCInfo(wallpaperManager) << "Library watcher:" << addedIds.size() << "added,"
+                             << removedIds.size() << "removed," << updated.size() << "updated";
+    emitCatalogChanges(addedIds, removedIds, updated);
 }
 
-WallpaperInfo WallpaperManager::parseProjectJson(const QString& projectPath)
+void WallpaperManager::ensureIndexLoaded()
 {
-    WallpaperInfo wallpaper;
+    if (m_index.isLoaded() || !m_index.load()) {
+        return;
+    }
     
-    QFile file(projectPath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qCWarning(wallpaperManager) << "Failed to open project.json:" << projectPath;
-        return wallpaper;
+    // Publish the catalog straight away so the grid fills before the first scan has
+    // finished stat-ing every workshop directory; the scan then corrects anything stale
+    if (m_wallpapers.isEmpty() && m_index.size() > 0) {
+        QList<WallpaperIndexEntry> entries = m_index.entries().values();
+        std::sort(entries.begin(), entries.end(), [](const WallpaperIndexEntry& a, const WallpaperIndexEntry& b) {
+            return a.path < b.path;
+        });
+        
+        m_wallpapers.reserve(entries.size());
+        for (const WallpaperIndexEntry& entry : entries) {
+            m_wallpapers.append(makeWallpaperInfoPtr(entry.info));
+        }
+        rebuildWallpaperSlots();
+        
+        qCInfo(wallpaperManager) << "Loaded" << m_wallpapers.size() << "wallpapers from library index";
+        emit wallpapersChanged();
     }
+}
+
+void WallpaperManager::applyScanResults(const QList<WallpaperIndexEntry>& results)
+{
+    // What consumers currently show; a refresh on top of it is published as a diff
+    const QList<WallpaperInfoPtr> previous = m_wallpapers;
+    const WallpaperIndex::EntryMap previousEntries = m_index.entries();
+    m_resetPending = previous.isEmpty();
     
-    QByteArray data = file.readAll();
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    QList<WallpaperIndexEntry> validEntries;
+    validEntries.reserve(results.size());
     
-    if (error.error != QJsonParseError::NoError) {
-        qCWarning(wallpaperManager) << "Failed to parse project.json:" << error.errorString();
-        return wallpaper;
+    // m_wallpaperSlots still describes the previous list until it is rebuilt below
+    m_wallpapers.clear();
+    m_wallpapers.reserve(results.size());
+    for (WallpaperIndexEntry entry : results) {
+        if (!entry.isValid()) {
+            continue;
+        }
+        
+        // Sizes measured while the scan was running only exist in the live index
+        auto before = previousEntries.constFind(entry.path);
+        if (!entry.hasCurrentSize() && before != previousEntries.constEnd()
+            && before->hasCurrentSize() && before->directoryModified == entry.directoryModified) {
+            entry.info.fileSize = before->info.fileSize;
+            entry.sizeModified = before->sizeModified;
+        }
+        validEntries.append(entry);
+        
+        // Unchanged records keep their handle, so anything holding one still sees the same object
+        auto slot = m_wallpaperSlots.constFind(entry.info.id);
+        if (slot != m_wallpaperSlots.constEnd() && before != previousEntries.constEnd()
+            && before->hasSameStatData(entry)) {
+            m_wallpapers.append(previous.at(slot.value()));
+        } else {
+            m_wallpapers.append(makeWallpaperInfoPtr(entry.info));
+        }
     }
+    rebuildWallpaperSlots();
     
-    QJsonObject root = doc.object();
+    int parsed = m_scanParsed.loadRelaxed();
+    int reused = validEntries.size() - parsed;
+    qCInfo(wallpaperManager) << "Found" << m_wallpapers.size() << "wallpapers"
+                             << "(" << parsed << "parsed," << qMax(0, reused) << "from index)";
     
-    // Extract basic info
-    wallpaper.id = extractWorkshopId(QFileInfo(projectPath).dir().path());
-    wallpaper.name = root.value("title").toString();
-    wallpaper.description = root.value("description").toString();
-    wallpaper.type = root.value("type").toString();
+    if (!m_resetPending) {
+        publishCatalogDiff(previous, previousEntries, validEntries);
+    }
+    
+    // Nothing was parsed and the directory set is the same size: every entry came
+    // straight from the index, so there is nothing new to write
+    if (parsed == 0 && validEntries.size() == m_index.size()) {
+        return;
+    }
+    
+    m_index.setEntries(validEntries);
+    m_index.save();
+}
+
+WallpaperIndexEntry WallpaperManager::scanWallpaperDirectory(const QString& dirPath,
+                                                             const WallpaperIndex::EntryMap& cache,
+                                                             bool withProperties,
+                                                             QAtomicInt* parsedCount)
+{
+    QFileInfo projectInfo(QDir(dirPath).filePath("project.json"));
+    if (!projectInfo.exists()) {
+        return WallpaperIndexEntry(); // Skip directories without project.json
+    }
+    
+    QFileInfo dirInfo(dirPath);
+    
+    // Warm path: unchanged stat data means the cached metadata is still valid
+    auto cached = cache.constFind(dirPath);
+    if (cached != cache.constEnd() && cached->matches(projectInfo, dirInfo)) {
+        return *cached;
+    }
+    
+    WallpaperIndexEntry entry;
+    entry.path = dirPath;
+    entry.setStatData(projectInfo, dirInfo);
+    entry.info = parseProjectJson(projectInfo.filePath(), withProperties);
+    if (entry.info.id.isEmpty()) {
+        return WallpaperIndexEntry();
+    }
     
-    // Extract file size
-    QFileInfo dirInfo(QFileInfo(projectPath).dir().path());
-    wallpaper.fileSize = dirInfo.size();
+    entry.info.path = dirPath;
+    entry.info.projectPath = projectInfo.filePath();
+    entry.info.previewPath = findPreviewImage(dirPath);
+    entry.info.placeholderColor = previewPlaceholderColor(entry.info.previewPath);
     
-    // Extract tags
-    QJsonArray tagsArray = root.value("tags").toArray();
-    QStringList tags;
-    for (const QJsonValue& tagValue : tagsArray) {
-        tags.append(tagValue.toString());
+    // Keep the last measured size until the background job has measured it again
+    if (cached != cache.constEnd()) {
+        entry.info.fileSize = cached->info.fileSize;
+        entry.sizeModified = cached->sizeModified;
     }
-    wallpaper.tags = tags;
     
-    // Extract properties - this is the key part for the Properties Panel
-    wallpaper.properties = extractProperties(root);
+    if (parsedCount) {
+        parsedCount->fetchAndAddRelaxed(1);
+    }
+    return entry;
+}
+
+WallpaperInfo WallpaperManager::parseProjectJson(const QString& projectPath, bool withProperties)
+{
+    WallpaperInfo wallpaper;
+    
+    // Only the fields the library shows are decoded; large subtrees such as embedded
+    // scene data are skipped without being loaded
+    ProjectJsonReader reader(withProperties);
+    if (!reader.readFile(projectPath)) {
+        qCWarning(wallpaperManager) << "Failed to parse project.json:" << projectPath << reader.errorString();
+        return wallpaper;
+    }
     
-    qCDebug(wallpaperManager) << "Parsed wallpaper:" << wallpaper.name 
-                              << "with" << wallpaper.properties.size() << "properties";
+    // Extract basic info
+    wallpaper.id = extractWorkshopId(QFileInfo(projectPath).dir().path());
+    wallpaper.name = reader.title();
+    wallpaper.description = reader.description();
+    wallpaper.type = reader.type();
+    
+    // fileSize is left for DirectorySizeCalculator, walking the directory here would
+    // make every parse pay for the whole wallpaper's contents
+    
+    wallpaper.tags = reader.tags();
+    
+    // Properties are only needed by the Properties Panel; in lazy mode they are
+    // loaded through getWallpaperProperties() when a wallpaper is opened
+    if (withProperties) {
+        wallpaper.properties = reader.properties();
+        if (reader.propertiesSkipped()) {
+            qCWarning(wallpaperManager) << "Properties in" << projectPath << "exceed"
+                                        << ProjectJsonReader::MAX_PROPERTIES_BYTES << "bytes, skipped";
+        }
+    }
     
     return wallpaper;
 }
 
+QJsonObject WallpaperManager::loadProjectProperties(const QString& projectPath)
+{
+    ProjectJsonReader reader(true);
+    if (!reader.readFile(projectPath)) {
+        qCWarning(wallpaperManager) << "Failed to parse project.json:" << projectPath << reader.errorString();
+        return QJsonObject();
+    }
+    
+    if (reader.propertiesSkipped()) {
+        qCWarning(wallpaperManager) << "Properties in" << projectPath << "exceed"
+                                    << ProjectJsonReader::MAX_PROPERTIES_BYTES << "bytes, skipped";
+    }
+    return reader.properties();
+}
+
 QJsonObject WallpaperManager::extractProperties(const QJsonObject& projectJson)
 {
     QJsonObject properties;
@@ -190,31 +703,118 @@ QJsonObject WallpaperManager::extractProperties(const QJsonObject& projectJson)
 
 QString WallpaperManager::findPreviewImage(const QString& wallpaperDir)
 {
-    QDir dir(wallpaperDir);
-    QStringList filters = {"preview.*", "thumb.*", "thumbnail.*"};
-    QStringList imageExtensions = {"jpg", "jpeg", "png", "gif", "bmp"};
-    
-    for (const QString& filter : filters) {
-        QStringList matches = dir.entryList({filter}, QDir::Files);
-        for (const QString& match : matches) {
-            QString ext = QFileInfo(match).suffix().toLower();
-            if (imageExtensions.contains(ext)) {
-                return dir.filePath(match);
+    // One directory enumeration per item. Ranking matches the old per-filter listings:
+    // preview.* beats thumb.* beats thumbnail.* (image extensions only), then any image
+    // by extension order; ties go to the name that sorts first, ignoring case.
+    static const QStringList prefixes = {"preview.", "thumb.", "thumbnail."};
+    static const QStringList imageExtensions = {"jpg", "jpeg", "png", "gif", "bmp"};
+    
+    QString prefixBest[3];
+    QString extensionBest[5];
+    
+    auto keepFirst = [](QString& best, const QString& candidate) {
+        if (best.isEmpty() || QString::compare(candidate, best, Qt::CaseInsensitive) < 0) {
+            best = candidate;
+        }
+    };
+    
+    QDirIterator it(wallpaperDir, QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        const QString fileName = it.fileName();
+        
+        int dot = fileName.lastIndexOf(QLatin1Char('.'));
+        if (dot < 0) {
+            continue;
+        }
+        int extensionRank = imageExtensions.indexOf(fileName.mid(dot + 1).toLower());
+        if (extensionRank < 0) {
+            continue;
+        }
+        
+        keepFirst(extensionBest[extensionRank], fileName);
+        for (int rank = 0; rank < prefixes.size(); ++rank) {
+            if (fileName.startsWith(prefixes[rank], Qt::CaseInsensitive)) {
+                keepFirst(prefixBest[rank], fileName);
+                break;
             }
         }
     }
     
-    // Fallback: look for any image file
-    for (const QString& ext : imageExtensions) {
-        QStringList images = dir.entryList({"*." + ext}, QDir::Files);
-        if (!images.isEmpty()) {
-            return dir.filePath(images.first());
+    QDir dir(wallpaperDir);
+    for (const QString& match : prefixBest) {
+        if (!match.isEmpty()) {
+            return dir.filePath(match);
+        }
+    }
+    for (const QString& match : extensionBest) {
+        if (!match.isEmpty()) {
+            return dir.filePath(match);
         }
     }
     
     return QString();
 }
 
+quint32 WallpaperManager::previewPlaceholderColor(const QString& previewPath)
+{
+    if (previewPath.isEmpty()) {
+        return 0;
+    }
+    
+    // A few dozen pixels are enough; JPEG previews decode straight at this size
+    QImageReader reader(previewPath);
+    const QSize sourceSize = reader.size();
+    if (sourceSize.isValid() && reader.supportsOption(QImageIOHandler::ScaledSize)) {
+        reader.setScaledSize(sourceSize.scaled(PLACEHOLDER_SAMPLE_SIZE, PLACEHOLDER_SAMPLE_SIZE,
+                                               Qt::KeepAspectRatio).expandedTo(QSize(1, 1)));
+    }
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return 0;
+    }
+    image = image.scaled(PLACEHOLDER_SAMPLE_SIZE, PLACEHOLDER_SAMPLE_SIZE, Qt::KeepAspectRatio, Qt::FastTransformation)
+                 .convertToFormat(QImage::Format_ARGB32);
+    
+    // Most common colour at 4 bits per channel, then the mean of the pixels in that bucket,
+    // so a red logo on black gives black rather than the muddy average of the two
+    QHash<int, int> counts;
+    int bestBucket = -1;
+    int bestCount = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            if (qAlpha(line[x]) < 128) {
+                continue;
+            }
+            const int bucket = (qRed(line[x]) >> 4) << 8 | (qGreen(line[x]) >> 4) << 4 | qBlue(line[x]) >> 4;
+            const int count = ++counts[bucket];
+            if (count > bestCount) {
+                bestCount = count;
+                bestBucket = bucket;
+            }
+        }
+    }
+    if (bestBucket < 0) {
+        return 0;
+    }
+    
+    qint64 red = 0, green = 0, blue = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const QRgb pixel = line[x];
+            if (qAlpha(pixel) >= 128
+                && ((qRed(pixel) >> 4) << 8 | (qGreen(pixel) >> 4) << 4 | qBlue(pixel) >> 4) == bestBucket) {
+                red += qRed(pixel);
+                green += qGreen(pixel);
+                blue += qBlue(pixel);
+            }
+        }
+    }
+    return qRgb(int(red / bestCount), int(green / bestCount), int(blue / bestCount));
+}
+
 QString WallpaperManager::extractWorkshopId(const QString& dirPath)
 {
     QFileInfo pathInfo(dirPath);
@@ -237,30 +837,107 @@ QString WallpaperManager::extractWorkshopId(const QString& dirPath)
     return dirName; // Use directory name as fallback
 }
 
-QList<WallpaperInfo> WallpaperManager::getAllWallpapers() const
+WallpaperInfoPtr WallpaperManager::findWallpaper(const QString& id) const
 {
-    return m_wallpapers;
+    auto it = m_wallpaperSlots.constFind(id);
+    if (it == m_wallpaperSlots.constEnd()) {
+        return WallpaperInfoPtr();
+    }
+    return m_wallpapers.at(it.value());
 }
 
 WallpaperInfo WallpaperManager::getWallpaperById(const QString& id) const
 {
-    for (const WallpaperInfo& wallpaper : m_wallpapers) {
-        if (wallpaper.id == id) {
-            return wallpaper;
-        }
-    }
-    return WallpaperInfo();
+    WallpaperInfoPtr wallpaper = findWallpaper(id);
+    return wallpaper ? *wallpaper : WallpaperInfo();
 }
 
 std::optional<WallpaperInfo> WallpaperManager::getWallpaperInfo(const QString& id) const
 {
-    WallpaperInfo wallpaper = getWallpaperById(id);
-    if (!wallpaper.id.isEmpty()) {
-        return wallpaper;
+    WallpaperInfoPtr wallpaper = findWallpaper(id);
+    if (wallpaper) {
+        return *wallpaper;
     }
     return std::nullopt;
 }
 
+QJsonObject WallpaperManager::getWallpaperProperties(const QString& id) const
+{
+    WallpaperInfoPtr wallpaper = findWallpaper(id);
+    if (!wallpaper) {
+        return QJsonObject();
+    }
+    if (!wallpaper->properties.isEmpty()) {
+        return wallpaper->properties;
+    }
+    
+    if (QJsonObject* cached = m_propertiesCache.object(id)) {
+        return *cached;
+    }
+    
+    // Entries reused from an older catalog may still carry an encoded blob;
+    // otherwise go back to project.json
+    QJsonObject properties = m_index.entries().value(wallpaper->path).properties();
+    if (properties.isEmpty()) {
+        properties = loadProjectProperties(wallpaper->projectPath);
+    }
+    
+    m_propertiesCache.insert(id, new QJsonObject(properties));
+    return properties;
+}
+
+void WallpaperManager::queueDirectorySizes()
+{
+    int queued = 0;
+    for (const WallpaperIndexEntry& entry : m_index.entries()) {
+        if (!entry.hasCurrentSize()) {
+            m_sizeCalculator->enqueue(entry.path, entry.directoryModified);
+            queued++;
+        }
+    }
+    
+    if (queued > 0) {
+        qCDebug(wallpaperManager) << "Measuring" << queued << "wallpaper directories in the background";
+    }
+}
+
+void WallpaperManager::onDirectorySizeCalculated(const QString& dirPath, qint64 directoryModified, qint64 size)
+{
+    auto it = m_index.entries().constFind(dirPath);
+    if (it == m_index.entries().constEnd() || it->directoryModified != directoryModified) {
+        return; // Removed or changed since the request; the calculator re-measures for the newer mtime
+    }
+    
+    WallpaperIndexEntry entry = *it;
+    const bool sizeChanged = entry.info.fileSize != size;
+    entry.info.fileSize = size;
+    entry.sizeModified = directoryModified;
+    m_index.insertEntry(entry);
+    m_sizeSaveTimer->start();
+    
+    auto slot = m_wallpaperSlots.constFind(entry.info.id);
+    if (!sizeChanged || slot == m_wallpaperSlots.constEnd()) {
+        return;
+    }
+    
+    WallpaperInfo info = *m_wallpapers.at(slot.value());
+    info.fileSize = size;
+    m_wallpapers[slot.value()] = makeWallpaperInfoPtr(info);
+    emit wallpaperUpdated(info.id, WallpaperInfo::FileSizeField);
+}
+
+void WallpaperManager::rebuildWallpaperSlots()
+{
+    m_wallpaperSlots.clear();
+    m_wallpaperSlots.reserve(m_wallpapers.size());
+    m_wallpaperPathSlots.clear();
+    m_wallpaperPathSlots.reserve(m_wallpapers.size());
+    for (int i = 0; i < m_wallpapers.size(); ++i) {
+        m_wallpaperSlots.insert(m_wallpapers[i]->id, i);
+        m_wallpaperPathSlots.insert(m_wallpapers[i]->path, i);
+    }
+}
+
 bool WallpaperManager::launchWallpaper(const QString& wallpaperId, const QStringList& additionalArgs)
 {
     ConfigManager& config = ConfigManager::instance();
@@ -271,12 +948,15 @@ bool WallpaperManager::launchWallpaper(const QString& wallpaperId, const QString
         return false;
     }
     
-    WallpaperInfo wallpaper = getWallpaperById(wallpaperId);
-    if (wallpaper.id.isEmpty()) {
+    WallpaperInfoPtr found = findWallpaper(wallpaperId);
+    if (!found) {
         emit errorOccurred("Wallpaper not found: " + wallpaperId);
         return false;
     }
     
+    // The handle keeps the record alive even if the library changes while the old process stops
+    const WallpaperInfo& wallpaper = *found;
+    
     // Stop current wallpaper if running
     stopWallpaper();
     
@@ -458,8 +1138,8 @@ bool WallpaperManager::launchMultiMonitorWallpaper(const QMap<QString, QString>&
         QString screenName = it.key();
         QString wallpaperId = it.value();
         
-        WallpaperInfo wallpaper = getWallpaperById(wallpaperId);
-        if (wallpaper.id.isEmpty()) {
+        WallpaperInfoPtr wallpaper = findWallpaper(wallpaperId);
+        if (!wallpaper) {
             emit errorOccurred("Wallpaper not found: " + wallpaperId);
             delete m_wallpaperProcess;
             m_wallpaperProcess = nullptr;
@@ -467,7 +1147,7 @@ bool WallpaperManager::launchMultiMonitorWallpaper(const QMap<QString, QString>&
         }
         
         args << "--screen-root" << screenName;
-        args << "--bg" << wallpaper.path;
+        args << "--bg" << wallpaper->path;
     }
     
     emit outputReceived(QString("Launching multi-monitor wallpaper setup (%1 screens)")
@@ -8,30 +8,16 @@
 #include <QJsonArray>
 #include <QDateTime>
 #include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QAtomicInt>
+#include <QSet>
+#include <QHash>
+#include <QCache>
 #include <optional>
+#include "WallpaperInfo.h"
+#include "WallpaperIndex.h"
 
-struct WallpaperInfo {
-    QString id;
-    QString name;
-    QString author;
-    QString authorId;
-    QString description;
-    QString type;
-    QString path;
-    QString previewPath;
-    QString projectPath;
-    QDateTime created;
-    QDateTime updated;
-    qint64 fileSize = 0;
-    QStringList tags;
-    QJsonObject properties;  // Properties from project.json
-    
-    WallpaperInfo() = default;
-    
-    bool operator==(const WallpaperInfo& other) const {
-        return id == other.id;
-    }
-};
+class DirectorySizeCalculator;
 
 class WallpaperManager : public QObject
 {
@@ -42,9 +28,15 @@ public:
     ~WallpaperManager();
 
     void refreshWallpapers();
-    QList<WallpaperInfo> getAllWallpapers() const;
+    QList<WallpaperInfoPtr> wallpapers() const { return m_wallpapers; }
+    int wallpaperCount() const { return m_wallpapers.size(); }
     WallpaperInfo getWallpaperById(const QString& id) const;
+    // O(1) lookup without copying; null if the id is unknown
+    WallpaperInfoPtr findWallpaper(const QString& id) const;
     std::optional<WallpaperInfo> getWallpaperInfo(const QString& id) const;
+    // Properties are not kept by the scan in lazy mode; they are decoded on demand
+    // from the catalog or project.json and kept in a small LRU
+    QJsonObject getWallpaperProperties(const QString& id) const;
 
     bool launchWallpaper(const QString& wallpaperId, const QStringList& additionalArgs = QStringList());
     void stopWallpaper();
@@ -58,6 +50,11 @@ signals:
     void refreshProgress(int current, int total);
     void refreshFinished();
     void wallpapersChanged();
+    // Incremental updates from the library watcher and from refreshes on top of an
+    // already populated list; wallpapersChanged() is only emitted when the list is reset
+    void wallpapersAdded(const QStringList& ids);
+    void wallpapersRemoved(const QStringList& ids);
+    void wallpaperUpdated(const QString& id, WallpaperInfo::Fields changed);
     void outputReceived(const QString& output);
     void errorOccurred(const QString& error);
     void wallpaperLaunched(const QString& wallpaperId);
@@ -67,21 +64,90 @@ private slots:
     void onProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
     void onProcessError(QProcess::ProcessError error);
     void onProcessOutput();
+    void onParallelScanFinished();
+    void onWatchedDirectoryChanged(const QString& path);
+    void processWatchedChanges();
+    void onDirectorySizeCalculated(const QString& dirPath, qint64 directoryModified, qint64 size);
 
 private:
     void scanWorkshopDirectories();
-    void processWallpaperDirectory(const QString& dirPath);
-    WallpaperInfo parseProjectJson(const QString& projectPath);
-    QJsonObject extractProperties(const QJsonObject& projectJson);
-    QString findPreviewImage(const QString& wallpaperDir);
-    QString extractWorkshopId(const QString& dirPath);
+    void startParallelScan();
+    void finishRefresh();
+    QStringList findWorkshopDirectories();
+    QStringList collectWallpaperDirectories(const QStringList& workshopPaths) const;
+    void ensureIndexLoaded();
+    void applyScanResults(const QList<WallpaperIndexEntry>& results);
+    
+    // Catalog change notifications
+    using FieldChanges = QList<QPair<QString, WallpaperInfo::Fields>>;
+    void publishCatalogDiff(const QList<WallpaperInfoPtr>& previous,
+                            const WallpaperIndex::EntryMap& previousEntries,
+                            const QList<WallpaperIndexEntry>& current);
+    void emitCatalogChanges(const QStringList& addedIds, const QStringList& removedIds,
+                            const FieldChanges& updated);
+    static WallpaperInfo::Fields changedFields(const WallpaperIndexEntry& before,
+                                               const WallpaperIndexEntry& after);
+    
+    // Library watch mode
+    void updateWatchedPaths();
+    QStringList rescanWorkshopRoot(const QString& workshopPath);
+    int findWallpaperIndexByPath(const QString& path) const;
+    void rebuildWallpaperSlots();
+    
+    // Background size accounting
+    void queueDirectorySizes();
+    
+    // Stateless parsing helpers - safe to call from scan worker threads
+    static WallpaperIndexEntry scanWallpaperDirectory(const QString& dirPath,
+                                                      const WallpaperIndex::EntryMap& cache,
+                                                      bool withProperties,
+                                                      QAtomicInt* parsedCount);
+    static WallpaperInfo parseProjectJson(const QString& projectPath, bool withProperties = true);
+    static QJsonObject loadProjectProperties(const QString& projectPath);
+    static QJsonObject extractProperties(const QJsonObject& projectJson);
+    static QString findPreviewImage(const QString& wallpaperDir);
+    static quint32 previewPlaceholderColor(const QString& previewPath);
+    static QString extractWorkshopId(const QString& dirPath);
     QStringList generatePropertyArguments(const QString& projectJsonPath);
     bool verifyProcessTerminated(qint64 pid);  // Helper to verify process is really dead
     
-    QList<WallpaperInfo> m_wallpapers;
+    QList<WallpaperInfoPtr> m_wallpapers;
+    QHash<QString, int> m_wallpaperSlots;  // id -> index into m_wallpapers
+    QHash<QString, int> m_wallpaperPathSlots;  // directory -> index into m_wallpapers
+    mutable QCache<QString, QJsonObject> m_propertiesCache;  // id -> decoded properties
+    bool m_scanWithProperties;  // Snapshot of !lazyPropertiesEnabled() for the running scan
+    
+    static constexpr int PROPERTIES_CACHE_SIZE = 64;
+    static constexpr int PLACEHOLDER_SAMPLE_SIZE = 32;  // Preview is sampled at most this wide for its colour
     QProcess* m_wallpaperProcess;
     QString m_currentWallpaperId;
     bool m_refreshing;
+    bool m_resetPending;  // Next finishRefresh() emits wallpapersChanged() instead of a diff
+    
+    // Parallel scan state
+    QFutureWatcher<WallpaperIndexEntry>* m_scanWatcher;
+    QAtomicInt m_scanProgress;
+    QAtomicInt m_scanParsed;
+    int m_scanTotal;
+    
+    // Persistent scan index (stat data + parsed metadata per directory)
+    WallpaperIndex m_index;
+    
+    // Directory sizes are measured off the GUI thread and written back to the index
+    // in batches, a catalog write per measured directory would be wasteful
+    DirectorySizeCalculator* m_sizeCalculator;
+    QTimer* m_sizeSaveTimer;
+    
+    static constexpr int SIZE_SAVE_DELAY_MS = 5000;
+    
+    // Library watch mode: workshop roots catch new/removed items, item
+    // directories catch updates; events are batched by the debounce timer
+    QFileSystemWatcher* m_libraryWatcher;
+    QTimer* m_watchDebounceTimer;
+    QStringList m_workshopPaths;
+    QSet<QString> m_pendingWatchPaths;
+    
+    static constexpr int WATCH_DEBOUNCE_MS = 1000;  // Steam writes many files per download
 };
 
 #endif // WALLPAPERMANAGER_H
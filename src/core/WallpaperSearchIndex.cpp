@@ -0,0 +1,166 @@
+#include "WallpaperSearchIndex.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+// Three UTF-16 code units packed into one key
+quint64 trigramKey(const QChar* chars)
+{
+    return (quint64(chars[0].unicode()) << 32) | (quint64(chars[1].unicode()) << 16) | chars[2].unicode();
+}
+
+} // namespace
+
+WallpaperSearchIndex::WallpaperSearchIndex()
+{
+}
+
+void WallpaperSearchIndex::clear()
+{
+    m_docIds.clear();
+    m_ids.clear();
+    m_texts.clear();
+    m_freeDocs.clear();
+    m_postings.clear();
+}
+
+QString WallpaperSearchIndex::searchableText(const WallpaperInfo& wallpaper)
+{
+    // A query typed into the search box never holds a newline, so no match spans two fields
+    QStringList fields;
+    fields << wallpaper.name << wallpaper.description << wallpaper.author << wallpaper.tags;
+    return fields.join(QLatin1Char('\n')).toCaseFolded();
+}
+
+bool WallpaperSearchIndex::matches(const WallpaperInfo& wallpaper, const QString& text)
+{
+    return searchableText(wallpaper).contains(text.toCaseFolded());
+}
+
+QList<quint64> WallpaperSearchIndex::trigrams(const QString& foldedText)
+{
+    QList<quint64> keys;
+    if (foldedText.size() < GRAM) {
+        return keys;
+    }
+    keys.reserve(foldedText.size() - GRAM + 1);
+    const QChar* chars = foldedText.constData();
+    for (int i = 0; i + GRAM <= foldedText.size(); ++i) {
+        keys.append(trigramKey(chars + i));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+void WallpaperSearchIndex::insert(const WallpaperInfo& wallpaper)
+{
+    if (wallpaper.id.isEmpty()) {
+        return;
+    }
+
+    const QString text = searchableText(wallpaper);
+    const auto existing = m_docIds.constFind(wallpaper.id);
+    if (existing != m_docIds.cend()) {
+        if (m_texts.at(existing.value()) == text) {
+            return;  // Only fields that are not searched changed
+        }
+        removeDoc(existing.value());
+    }
+
+    DocId doc;
+    if (!m_freeDocs.isEmpty()) {
+        doc = m_freeDocs.takeLast();
+        m_ids[doc] = wallpaper.id;
+        m_texts[doc] = text;
+    } else {
+        doc = m_ids.size();
+        m_ids.append(wallpaper.id);
+        m_texts.append(text);
+    }
+    m_docIds.insert(wallpaper.id, doc);
+
+    for (quint64 key : trigrams(text)) {
+        // New ids grow while the index is built, so this is an append in the common case
+        QList<DocId>& postings = m_postings[key];
+        postings.insert(std::lower_bound(postings.begin(), postings.end(), doc), doc);
+    }
+}
+
+void WallpaperSearchIndex::remove(const QString& wallpaperId)
+{
+    const auto it = m_docIds.constFind(wallpaperId);
+    if (it != m_docIds.cend()) {
+        removeDoc(it.value());
+    }
+}
+
+void WallpaperSearchIndex::removeDoc(DocId doc)
+{
+    // The stored text yields exactly the trigrams the document was posted under
+    for (quint64 key : trigrams(m_texts.at(doc))) {
+        auto it = m_postings.find(key);
+        if (it == m_postings.end()) {
+            continue;
+        }
+        auto position = std::lower_bound(it->begin(), it->end(), doc);
+        if (position != it->end() && *position == doc) {
+            it->erase(position);
+        }
+        if (it->isEmpty()) {
+            m_postings.erase(it);
+        }
+    }
+
+    m_docIds.remove(m_ids.at(doc));
+    m_ids[doc].clear();
+    m_texts[doc].clear();
+    m_freeDocs.append(doc);
+}
+
+QSet<QString> WallpaperSearchIndex::search(const QString& text) const
+{
+    QSet<QString> result;
+    const QString query = text.toCaseFolded();
+
+    if (query.size() < GRAM) {
+        // Too short for a trigram; the texts are folded already, so this is a plain scan
+        for (DocId doc = 0; doc < m_ids.size(); ++doc) {
+            if (!m_ids.at(doc).isEmpty() && m_texts.at(doc).contains(query)) {
+                result.insert(m_ids.at(doc));
+            }
+        }
+        return result;
+    }
+
+    QList<const QList<DocId>*> lists;
+    for (quint64 key : trigrams(query)) {
+        const auto it = m_postings.constFind(key);
+        if (it == m_postings.cend()) {
+            return result;  // A trigram of the query occurs nowhere
+        }
+        lists.append(&it.value());
+    }
+
+    // Shortest list first keeps every intersection at most as large as the rarest trigram
+    std::sort(lists.begin(), lists.end(), [](const QList<DocId>* a, const QList<DocId>* b) {
+        return a->size() < b->size();
+    });
+    QList<DocId> candidates = *lists.first();
+    for (int i = 1; i < lists.size() && !candidates.isEmpty(); ++i) {
+        QList<DocId> remaining;
+        remaining.reserve(candidates.size());
+        std::set_intersection(candidates.cbegin(), candidates.cend(), lists.at(i)->cbegin(), lists.at(i)->cend(),
+                              std::back_inserter(remaining));
+        candidates.swap(remaining);
+    }
+
+    // All trigrams being present does not mean they are adjacent and in order
+    for (DocId doc : std::as_const(candidates)) {
+        if (m_texts.at(doc).contains(query)) {
+            result.insert(m_ids.at(doc));
+        }
+    }
+    return result;
+}
@@ -0,0 +1,54 @@
+#ifndef WALLPAPERSEARCHINDEX_H
+#define WALLPAPERSEARCHINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include "WallpaperInfo.h"
+
+// In-memory trigram index over the searchable text of the library.
+//
+// Each wallpaper's name, description, author and tags are case folded once, when the
+// wallpaper is inserted, and every distinct three-character sequence of that text gets
+// a posting list of the documents containing it. A query of three or more characters
+// intersects the posting lists of its own trigrams, shortest first, and only the few
+// documents left are checked with a plain substring match, so results are exactly those
+// of a case-insensitive contains() over the fields without touching the other documents.
+// Shorter queries are matched against the folded texts directly. Entries are replaced
+// or removed one at a time as the library reports changes. GUI thread only.
+class WallpaperSearchIndex
+{
+public:
+    WallpaperSearchIndex();
+
+    void clear();
+    // Adds the wallpaper, or re-indexes it if its id is already present
+    void insert(const WallpaperInfo& wallpaper);
+    void remove(const QString& wallpaperId);
+    bool contains(const QString& wallpaperId) const { return m_docIds.contains(wallpaperId); }
+    int size() const { return m_docIds.size(); }
+
+    // Ids of the wallpapers whose indexed text contains text, ignoring case
+    QSet<QString> search(const QString& text) const;
+    // The same test for a single wallpaper that is not in the index
+    static bool matches(const WallpaperInfo& wallpaper, const QString& text);
+
+private:
+    using DocId = int;
+
+    static QString searchableText(const WallpaperInfo& wallpaper);
+    static QList<quint64> trigrams(const QString& foldedText);
+    void removeDoc(DocId doc);
+
+    QHash<QString, DocId> m_docIds;
+    QStringList m_ids;                         // DocId -> wallpaper id, empty for free slots
+    QStringList m_texts;                       // DocId -> case folded searchable text
+    QList<DocId> m_freeDocs;                   // Slots of removed wallpapers, reused first
+    QHash<quint64, QList<DocId>> m_postings;   // Trigram -> ascending doc ids
+
+    static constexpr int GRAM = 3;
+};
+
+#endif // WALLPAPERSEARCHINDEX_H
@@ -0,0 +1,142 @@
+#include "AnimationDiskCache.h"
+#include "ConfigManager.h"
+#include <QBuffer>
+#include <QDataStream>
+#include <QImageWriter>
+#include <QPainter>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(animationDiskCache, "app.animationDiskCache")
+
+AnimationDiskCache& AnimationDiskCache::instance()
+{
+    static AnimationDiskCache instance;
+    return instance;
+}
+
+AnimationDiskCache::AnimationDiskCache()
+    : m_directory("animations", qint64(qMax(32, ConfigManager::instance().animationDiskCacheMB())) * 1024 * 1024,
+                  TRIM_INTERVAL)
+{
+}
+
+QString AnimationDiskCache::entryPath(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize,
+                                      const QSize& targetSize) const
+{
+    // A new entry layout gets new names instead of failing to parse old files
+    return m_directory.entryPath(sourcePath, sourceModified, sourceSize, targetSize,
+                                 QString::number(ENTRY_VERSION));
+}
+
+bool AnimationDiskCache::load(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize,
+                              const QSize& targetSize, QList<QImage>* frames, QList<int>* delays)
+{
+    const QString path = entryPath(sourcePath, sourceModified, sourceSize, targetSize);
+    const QByteArray data = m_directory.read(path);
+    if (data.isEmpty()) {
+        return false;
+    }
+
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QSize frameSize;
+    QList<int> frameDelays;
+    QByteArray sheetData;
+    in >> magic >> version >> frameSize >> frameDelays >> sheetData;
+
+    QImage sheet;
+    if (in.status() == QDataStream::Ok && magic == ENTRY_MAGIC && version == ENTRY_VERSION) {
+        sheet = QImage::fromData(sheetData);
+    }
+    const int frameCount = frameDelays.size();
+    if (sheet.isNull() || frameCount == 0 || frameSize.isEmpty() || sheet.width() != frameSize.width()
+        || sheet.height() != frameSize.height() * frameCount) {
+        qCDebug(animationDiskCache) << "Cannot decode sprite sheet for" << sourcePath;
+        m_directory.remove(path);
+        return false;
+    }
+
+    frames->clear();
+    frames->reserve(frameCount);
+    for (int i = 0; i < frameCount; ++i) {
+        frames->append(sheet.copy(0, i * frameSize.height(), frameSize.width(), frameSize.height()));
+    }
+    *delays = frameDelays;
+    return true;
+}
+
+void AnimationDiskCache::store(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize,
+                               const QSize& targetSize, const QList<QImage>& frames, const QList<int>& delays)
+{
+    if (frames.isEmpty() || frames.size() != delays.size()) {
+        return;
+    }
+
+    // A sprite sheet needs every frame at one size; clips the reader could not size are not kept
+    const QSize frameSize = frames.first().size();
+    if (frameSize.isEmpty() || qint64(frameSize.height()) * frames.size() > MAX_SHEET_HEIGHT) {
+        return;
+    }
+    bool transparent = false;
+    for (const QImage& frame : frames) {
+        if (frame.size() != frameSize) {
+            return;
+        }
+        transparent = transparent || hasTransparency(frame);
+    }
+
+    QImage sheet(frameSize.width(), frameSize.height() * frames.size(),
+                 transparent ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32);
+    sheet.fill(Qt::transparent);
+    {
+        QPainter painter(&sheet);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (int i = 0; i < frames.size(); ++i) {
+            painter.drawImage(0, i * frameSize.height(), frames.at(i));
+        }
+    }
+
+    QByteArray sheetData;
+    QBuffer buffer(&sheetData);
+    buffer.open(QIODevice::WriteOnly);
+    const QByteArray format = transparent ? "png" : "jpg";
+    QImageWriter writer(&buffer, format);
+    if (format == "jpg") {
+        writer.setQuality(JPEG_QUALITY);
+    }
+    if (!writer.write(sheet)) {
+        qCDebug(animationDiskCache) << "Failed to encode sprite sheet for" << sourcePath << writer.errorString();
+        return;
+    }
+
+    QByteArray entry;
+    QDataStream out(&entry, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << ENTRY_MAGIC << ENTRY_VERSION << frameSize << delays << sheetData;
+    if (out.status() != QDataStream::Ok
+        || !m_directory.write(entryPath(sourcePath, sourceModified, sourceSize, targetSize), entry)) {
+        return;
+    }
+    qCDebug(animationDiskCache) << "Transcoded" << sourcePath << "to" << frames.size() << "frames,"
+                                << sheetData.size() / 1024 << "KiB";
+}
+
+bool AnimationDiskCache::hasTransparency(const QImage& image)
+{
+    if (!image.hasAlphaChannel()) {
+        return false;
+    }
+    // GIF frames come back with an alpha channel whether or not any pixel uses it
+    const QImage argb = image.convertToFormat(QImage::Format_ARGB32);
+    for (int y = 0; y < argb.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(argb.constScanLine(y));
+        for (int x = 0; x < argb.width(); ++x) {
+            if (qAlpha(line[x]) != 255) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,52 @@
+#ifndef ANIMATIONDISKCACHE_H
+#define ANIMATIONDISKCACHE_H
+
+#include <QString>
+#include <QImage>
+#include <QList>
+#include <QSize>
+#include "DiskCacheDirectory.h"
+
+// Persistent cache of animated previews transcoded for playback at tile size.
+//
+// A workshop GIF is often several megabytes of full-size frames; the first time it is
+// shown its frames are scaled, frame-rate limited and written here as a single sprite
+// sheet (frames stacked top to bottom) plus the per-frame delays, so later runs read
+// one small JPEG or PNG instead of decoding the source again. Entries live in their
+// own DiskCacheDirectory, keyed and evicted like ThumbnailDiskCache ones. All methods
+// may be called from worker threads.
+class AnimationDiskCache
+{
+public:
+    static AnimationDiskCache& instance();
+
+    bool load(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize, const QSize& targetSize,
+              QList<QImage>* frames, QList<int>* delays);
+    void store(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize, const QSize& targetSize,
+               const QList<QImage>& frames, const QList<int>& delays);
+
+    QString cacheDir() const { return m_directory.path(); }
+    qint64 maxBytes() const { return m_directory.maxBytes(); }
+
+    // Drops least recently used entries until the cache is below its cap
+    void trim() { m_directory.trim(); }
+
+private:
+    AnimationDiskCache();
+    AnimationDiskCache(const AnimationDiskCache&) = delete;
+    AnimationDiskCache& operator=(const AnimationDiskCache&) = delete;
+
+    QString entryPath(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize,
+                      const QSize& targetSize) const;
+    static bool hasTransparency(const QImage& image);
+
+    DiskCacheDirectory m_directory;
+
+    static constexpr quint32 ENTRY_MAGIC = 0x57414e49;  // "WANI"
+    static constexpr quint32 ENTRY_VERSION = 1;
+    static constexpr int TRIM_INTERVAL = 16;  // Entries are large, re-measure more often than thumbnails
+    static constexpr int JPEG_QUALITY = 85;
+    static constexpr int MAX_SHEET_HEIGHT = 65000;  // JPEG dimensions are 16-bit
+};
+
+#endif // ANIMATIONDISKCACHE_H
@@ -0,0 +1,121 @@
+#include "DiskCacheDirectory.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QMutexLocker>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(diskCacheDirectory, "app.diskCacheDirectory")
+
+DiskCacheDirectory::DiskCacheDirectory(const QString& name, qint64 maxBytes, int trimInterval)
+    : m_name(name)
+    , m_maxBytes(maxBytes)
+    , m_trimInterval(qMax(1, trimInterval))
+    , m_totalBytes(-1)
+    , m_writesSinceTrim(0)
+{
+    m_path = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+             + "/wallpaperengine-gui/" + name;
+    QDir().mkpath(m_path);
+}
+
+QString DiskCacheDirectory::entryPath(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize,
+                                      const QSize& targetSize, const QString& salt) const
+{
+    QString key = QString("\n%1\n%2\n%3x%4").arg(sourceModified).arg(sourceSize)
+                      .arg(targetSize.width()).arg(targetSize.height());
+    if (!salt.isEmpty()) {
+        key += QLatin1Char('\n') + salt;
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(sourcePath.toUtf8());
+    hash.addData(key.toUtf8());
+    return m_path + QLatin1Char('/') + QString::fromLatin1(hash.result().toHex());
+}
+
+QByteArray DiskCacheDirectory::read(const QString& entryPath)
+{
+    QFile file(entryPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    const QByteArray data = file.readAll();
+    file.close();
+
+    // Trims go by mtime, oldest first, so this keeps the entry off the eviction end
+    if (!data.isEmpty() && file.open(QIODevice::ReadWrite)) {
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+    return data;
+}
+
+bool DiskCacheDirectory::write(const QString& entryPath, const QByteArray& data)
+{
+    // QSaveFile keeps a concurrent reader from ever seeing half an entry
+    QSaveFile file(entryPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(diskCacheDirectory) << "Cannot write cache entry" << entryPath << file.errorString();
+        return false;
+    }
+    if (file.write(data) != data.size() || !file.commit()) {
+        qCDebug(diskCacheDirectory) << "Failed to write cache entry" << entryPath << file.errorString();
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (m_totalBytes >= 0) {
+        m_totalBytes += data.size();
+    }
+    if (m_totalBytes < 0 || m_totalBytes > m_maxBytes || ++m_writesSinceTrim >= m_trimInterval) {
+        trimLocked();
+    }
+    return true;
+}
+
+void DiskCacheDirectory::remove(const QString& entryPath)
+{
+    qCDebug(diskCacheDirectory) << "Dropping unreadable cache entry" << entryPath;
+    QFile::remove(entryPath);
+}
+
+void DiskCacheDirectory::trim()
+{
+    QMutexLocker locker(&m_mutex);
+    trimLocked();
+}
+
+void DiskCacheDirectory::trimLocked()
+{
+    m_writesSinceTrim = 0;
+
+    QDir dir(m_path);
+    const QFileInfoList entries = dir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot,
+                                                    QDir::Time | QDir::Reversed);
+    qint64 total = 0;
+    for (const QFileInfo& entry : entries) {
+        total += entry.size();
+    }
+
+    if (total > m_maxBytes) {
+        // Go a little below the cap so the next few writes do not trim again straight away
+        const qint64 goal = m_maxBytes * 9 / 10;
+        int removed = 0;
+        for (const QFileInfo& entry : entries) {
+            if (total <= goal) {
+                break;
+            }
+            if (QFile::remove(entry.filePath())) {
+                total -= entry.size();
+                removed++;
+            }
+        }
+        qCDebug(diskCacheDirectory) << "Evicted" << removed << m_name << "entries, cache now" << total << "bytes";
+    }
+
+    m_totalBytes = total;
+}
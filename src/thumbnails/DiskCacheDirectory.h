@@ -0,0 +1,56 @@
+#ifndef DISKCACHEDIRECTORY_H
+#define DISKCACHEDIRECTORY_H
+
+#include <QString>
+#include <QByteArray>
+#include <QSize>
+#include <QMutex>
+
+// A directory of content-addressed cache entries kept under a size cap.
+//
+// Entry names are a hash of the source path, its mtime and size, and the target size,
+// so an updated source simply misses and the stale entry ages out. Reads refresh the
+// entry's mtime, writes are atomic and counted, and the least recently used files are
+// removed once the directory outgrows its cap. Only the bytes of an entry pass through
+// here; encoding and decoding them is up to the owning cache. All methods may be called
+// from worker threads.
+class DiskCacheDirectory
+{
+public:
+    // name is the subdirectory of the application cache directory, and is used in logs
+    DiskCacheDirectory(const QString& name, qint64 maxBytes, int trimInterval);
+
+    QString path() const { return m_path; }
+    qint64 maxBytes() const { return m_maxBytes; }
+
+    // salt, if not empty, separates entries of different payload versions
+    QString entryPath(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize,
+                      const QSize& targetSize, const QString& salt = QString()) const;
+
+    // Contents of the entry, empty on a miss; a hit counts as a use for the trim
+    QByteArray read(const QString& entryPath);
+    // Replaces the entry, trimming the directory every trimInterval writes or when it is full
+    bool write(const QString& entryPath, const QByteArray& data);
+    // For entries the owner could not decode
+    void remove(const QString& entryPath);
+
+    // Drops least recently used entries until the directory is below its cap
+    void trim();
+
+private:
+    DiskCacheDirectory(const DiskCacheDirectory&) = delete;
+    DiskCacheDirectory& operator=(const DiskCacheDirectory&) = delete;
+
+    void trimLocked();
+
+    QString m_name;
+    QString m_path;
+    qint64 m_maxBytes;
+    int m_trimInterval;
+
+    QMutex m_mutex;           // Guards the accounting below and serialises trims
+    qint64 m_totalBytes;      // -1 until the directory has been measured once
+    int m_writesSinceTrim;
+};
+
+#endif // DISKCACHEDIRECTORY_H
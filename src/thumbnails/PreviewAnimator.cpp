@@ -0,0 +1,488 @@
+#include "PreviewAnimator.h"
+#include "AnimationDiskCache.h"
+#include "ConfigManager.h"
+#include <QFileInfo>
+#include <QDateTime>
+#include <QImageReader>
+#include <QMetaObject>
+#include <QCoreApplication>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(previewAnimator, "app.previewAnimator")
+
+PreviewAnimator& PreviewAnimator::instance()
+{
+    static PreviewAnimator instance;
+    return instance;
+}
+
+PreviewAnimator::PreviewAnimator(QObject* parent)
+    : QObject(parent)
+    , m_clips(qMax(16, ConfigManager::instance().thumbnailAnimationCacheMB()) * 1024)
+    , m_nextPlaying(0)
+    , m_maxPlaying(qMax(1, ConfigManager::instance().maxPreviewAnimations()))
+    , m_transcode(ConfigManager::instance().transcodeAnimatedPreviews())
+    , m_nextHandle(1)
+{
+    // GIF decoding cannot be scaled in the reader, so keep it to a couple of cores
+    m_pool.setMaxThreadCount(2);
+    m_pool.setObjectName("PreviewAnimationPool");
+    if (m_transcode) {
+        AnimationDiskCache::instance();  // Create on the GUI thread, it reads the config
+    }
+
+    m_timer.setInterval(TICK_MS);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &PreviewAnimator::onTick);
+    m_clock.start();
+
+    // The singleton itself outlives QApplication; its workers, timer and frames must not
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, this, &PreviewAnimator::shutdown);
+    }
+}
+
+PreviewAnimator::~PreviewAnimator()
+{
+    shutdown();
+}
+
+void PreviewAnimator::shutdown()
+{
+    for (const QSharedPointer<QAtomicInt>& cancelled : std::as_const(m_decoding)) {
+        cancelled->storeRelaxed(1);
+    }
+    m_decoding.clear();
+    m_pool.clear();
+    m_pool.waitForDone();
+
+    // Views detaching later find their handles gone, which detach() already allows
+    m_timer.stop();
+    m_subscribers.clear();
+    m_playing.clear();
+    m_waiting.clear();
+    m_nextPlaying = 0;
+    m_clips.clear();
+    m_failedClips.clear();
+}
+
+bool PreviewAnimator::isStill(const Subscriber& subscriber)
+{
+    return subscriber.ready && (!subscriber.clip || subscriber.clip->frames.size() < 2);
+}
+
+QString PreviewAnimator::key(const QString& wallpaperId, const QString& sourcePath, const QSize& targetSize)
+{
+    // A replaced or rewritten preview file must not match the clip decoded from the old one
+    const qint64 modified = QFileInfo(sourcePath).lastModified().toMSecsSinceEpoch();
+    return QString("%1@%2x%3@%4@%5").arg(wallpaperId).arg(targetSize.width()).arg(targetSize.height())
+        .arg(modified).arg(sourcePath);
+}
+
+PreviewAnimator::Handle PreviewAnimator::attach(const QString& wallpaperId, const QString& sourcePath,
+                                                const QSize& targetSize, QObject* receiver,
+                                                FrameCallback callback)
+{
+    const Handle handle = m_nextHandle++;
+
+    Subscriber subscriber;
+    subscriber.key = key(wallpaperId, sourcePath, targetSize);
+    subscriber.receiver = receiver;
+    subscriber.callback = std::move(callback);
+
+    if (receiver && !m_trackedReceivers.contains(receiver)) {
+        m_trackedReceivers.insert(receiver);
+        connect(receiver, &QObject::destroyed, this, [this](QObject* object) {
+            m_trackedReceivers.remove(object);
+            detachReceiver(object);
+        });
+    }
+
+    // A clip that failed to decode is not retried until its file changes
+    if (m_failedClips.contains(subscriber.key)) {
+        if (subscriber.callback) {
+            subscriber.callback(QPixmap());
+        }
+        return 0;
+    }
+
+    CachedClip* cached = m_clips.object(subscriber.key);
+    if (cached) {
+        subscriber.clip = cached->clip;
+        subscriber.ready = true;
+    }
+    const QString clipKey = subscriber.key;
+    const ClipPtr clip = subscriber.clip;
+    const FrameCallback firstFrameCallback = subscriber.callback;
+    m_subscribers.insert(handle, subscriber);
+
+    if (clip) {
+        // Already decoded for another view, the first frame is there straight away
+        if (firstFrameCallback) {
+            firstFrameCallback(clip->frames.first());
+        }
+    } else if (!m_decoding.contains(clipKey)) {
+        startDecode(clipKey, sourcePath, targetSize);
+    }
+    return handle;
+}
+
+void PreviewAnimator::detach(Handle handle)
+{
+    auto it = m_subscribers.find(handle);
+    if (it == m_subscribers.end()) {
+        return;
+    }
+    const QString clipKey = it->key;
+    const bool waiting = !it->ready;
+    m_playing.removeOne(handle);
+    m_waiting.removeOne(handle);
+    m_subscribers.erase(it);
+    promoteWaiting();
+
+    // Nobody else waiting for this clip: stop decoding it
+    if (waiting && m_decoding.contains(clipKey)) {
+        bool stillWanted = false;
+        for (const Subscriber& subscriber : std::as_const(m_subscribers)) {
+            if (subscriber.key == clipKey && !subscriber.ready) {
+                stillWanted = true;
+                break;
+            }
+        }
+        if (!stillWanted) {
+            m_decoding.take(clipKey)->storeRelaxed(1);
+        }
+    }
+    updateTimer();
+}
+
+void PreviewAnimator::detachReceiver(QObject* receiver)
+{
+    QList<Handle> handles;
+    for (auto it = m_subscribers.cbegin(); it != m_subscribers.cend(); ++it) {
+        // The QPointer is already null once destroyed() fires
+        if (it->receiver.isNull() || it->receiver.data() == receiver) {
+            handles.append(it.key());
+        }
+    }
+    for (Handle handle : handles) {
+        detach(handle);
+    }
+}
+
+void PreviewAnimator::setPlaying(Handle handle, bool playing)
+{
+    auto it = m_subscribers.find(handle);
+    if (it == m_subscribers.end() || it->playing == playing) {
+        return;
+    }
+
+    it->playing = playing;
+    if (playing) {
+        if (isStill(*it)) {
+            return;
+        }
+        if (m_playing.size() < m_maxPlaying) {
+            resume(handle);
+        } else {
+            m_waiting.append(handle);
+        }
+    } else {
+        m_playing.removeOne(handle);
+        m_waiting.removeOne(handle);
+        promoteWaiting();
+    }
+    updateTimer();
+}
+
+void PreviewAnimator::setMaxPlaying(int count)
+{
+    count = qMax(1, count);
+    if (count == m_maxPlaying) {
+        return;
+    }
+    m_maxPlaying = count;
+
+    // Handles over the new cap keep their frame and go back to the front of the queue
+    while (m_playing.size() > m_maxPlaying) {
+        m_waiting.prepend(m_playing.takeLast());
+    }
+    promoteWaiting();
+    updateTimer();
+    qCDebug(previewAnimator) << "Concurrent preview animations limited to" << m_maxPlaying;
+}
+
+void PreviewAnimator::setTranscodeEnabled(bool enabled)
+{
+    if (enabled) {
+        AnimationDiskCache::instance();
+    }
+    m_transcode = enabled;
+}
+
+void PreviewAnimator::resume(Handle handle)
+{
+    auto it = m_subscribers.find(handle);
+    if (it == m_subscribers.end() || isStill(*it)) {
+        return;  // Nothing to advance, so it does not take a slot
+    }
+    if (it->clip) {
+        it->nextFrameAt = m_clock.elapsed() + it->clip->delays.at(it->frame);
+    }
+    m_playing.append(handle);
+}
+
+void PreviewAnimator::promoteWaiting()
+{
+    while (m_playing.size() < m_maxPlaying && !m_waiting.isEmpty()) {
+        resume(m_waiting.takeFirst());
+    }
+}
+
+bool PreviewAnimator::isPlaying(Handle handle) const
+{
+    auto it = m_subscribers.find(handle);
+    return it != m_subscribers.end() && it->playing;
+}
+
+void PreviewAnimator::updateTimer()
+{
+    if (m_playing.isEmpty()) {
+        m_timer.stop();
+    } else if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void PreviewAnimator::startDecode(const QString& clipKey, const QString& sourcePath, const QSize& targetSize)
+{
+    QSharedPointer<QAtomicInt> cancelled = QSharedPointer<QAtomicInt>::create(0);
+    m_decoding.insert(clipKey, cancelled);
+
+    const bool transcode = m_transcode;
+    m_pool.start([this, clipKey, sourcePath, targetSize, transcode, cancelled]() {
+        DecodedClip decoded = decodeClip(sourcePath, targetSize, transcode, cancelled);
+        if (cancelled->loadRelaxed()) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this, clipKey, cancelled, decoded]() {
+            onClipDecoded(clipKey, cancelled, decoded);
+        }, Qt::QueuedConnection);
+    });
+}
+
+PreviewAnimator::DecodedClip PreviewAnimator::decodeClip(const QString& sourcePath, const QSize& targetSize,
+                                                         bool transcode,
+                                                         const QSharedPointer<QAtomicInt>& cancelled)
+{
+    const QFileInfo sourceInfo(sourcePath);
+    if (!sourceInfo.isFile()) {
+        return DecodedClip();
+    }
+    const qint64 modified = sourceInfo.lastModified().toMSecsSinceEpoch();
+
+    // One small sprite sheet read instead of decoding every full-size GIF frame again
+    DecodedClip decoded;
+    if (transcode && AnimationDiskCache::instance().load(sourcePath, modified, sourceInfo.size(), targetSize,
+                                                         &decoded.frames, &decoded.delays)) {
+        for (QImage& frame : decoded.frames) {
+            frame = frame.convertToFormat(frame.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                                  : QImage::Format_RGB32);
+        }
+        return decoded;
+    }
+
+    decoded = decodeSource(sourcePath, targetSize, cancelled);
+    limitFrameRate(decoded);
+    if (transcode && !cancelled->loadRelaxed()) {
+        AnimationDiskCache::instance().store(sourcePath, modified, sourceInfo.size(), targetSize,
+                                             decoded.frames, decoded.delays);
+    }
+    return decoded;
+}
+
+PreviewAnimator::DecodedClip PreviewAnimator::decodeSource(const QString& sourcePath, const QSize& targetSize,
+                                                           const QSharedPointer<QAtomicInt>& cancelled)
+{
+    DecodedClip decoded;
+    QImageReader reader(sourcePath);
+    if (!reader.canRead()) {
+        qCDebug(previewAnimator) << "Cannot read animated preview" << sourcePath << reader.errorString();
+        return decoded;
+    }
+
+    const QSize sourceSize = reader.size();
+    QSize frameSize = sourceSize;
+    if (sourceSize.isValid() && targetSize.isValid()) {
+        frameSize = sourceSize.scaled(targetSize, Qt::KeepAspectRatio);
+        if (frameSize != sourceSize && reader.supportsOption(QImageIOHandler::ScaledSize)) {
+            reader.setScaledSize(frameSize);
+        }
+    }
+
+    qint64 bytes = 0;
+    while (decoded.frames.size() < MAX_FRAMES) {
+        if (cancelled->loadRelaxed()) {
+            return DecodedClip();
+        }
+
+        QImage image = reader.read();
+        if (image.isNull()) {
+            break;
+        }
+        if (frameSize.isValid() && image.size() != frameSize) {
+            image = image.scaled(frameSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        }
+        // The formats the raster engine blits fastest
+        image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                              : QImage::Format_RGB32);
+
+        int delay = reader.nextImageDelay();
+        if (delay <= 10) {
+            delay = DEFAULT_FRAME_DELAY_MS;
+        }
+        decoded.delays.append(qMax(int(MIN_FRAME_DELAY_MS), delay));
+        bytes += image.sizeInBytes();
+        decoded.frames.append(image);
+
+        if (bytes >= MAX_CLIP_BYTES || !reader.canRead()) {
+            break;
+        }
+    }
+
+    if (decoded.frames.size() == MAX_FRAMES || bytes >= MAX_CLIP_BYTES) {
+        qCDebug(previewAnimator) << "Truncated animated preview" << sourcePath << "at" << decoded.frames.size()
+                                 << "frames";
+    }
+    return decoded;
+}
+
+void PreviewAnimator::limitFrameRate(DecodedClip& clip)
+{
+    if (clip.frames.size() < 2) {
+        return;
+    }
+
+    // A frame shorter than the playback step is dropped and its time given to the one before it
+    DecodedClip limited;
+    limited.frames.reserve(clip.frames.size());
+    limited.delays.reserve(clip.delays.size());
+    for (int i = 0; i < clip.frames.size(); ++i) {
+        if (!limited.frames.isEmpty() && limited.delays.last() < MIN_PLAYBACK_DELAY_MS) {
+            limited.delays.last() += clip.delays.at(i);
+            continue;
+        }
+        limited.frames.append(clip.frames.at(i));
+        limited.delays.append(clip.delays.at(i));
+    }
+    clip = limited;
+}
+
+void PreviewAnimator::onClipDecoded(const QString& clipKey, const QSharedPointer<QAtomicInt>& cancelled,
+                                    const DecodedClip& decoded)
+{
+    // A newer decode of the same clip may have been started after this one was cancelled
+    if (m_decoding.value(clipKey) == cancelled) {
+        m_decoding.remove(clipKey);
+    }
+    if (cancelled->loadRelaxed()) {
+        return;  // Nobody is waiting for it any more, or the application is quitting
+    }
+
+    ClipPtr clip;
+    if (!decoded.frames.isEmpty()) {
+        QSharedPointer<Clip> newClip = QSharedPointer<Clip>::create();
+        qint64 bytes = 0;
+        newClip->frames.reserve(decoded.frames.size());
+        for (const QImage& image : decoded.frames) {
+            newClip->frames.append(QPixmap::fromImage(image));
+            bytes += image.sizeInBytes();
+        }
+        newClip->delays = decoded.delays;
+        clip = newClip;
+
+        CachedClip* cached = new CachedClip;
+        cached->clip = clip;
+        m_clips.insert(clipKey, cached, int(qMax<qint64>(1, bytes / 1024)));
+    } else {
+        m_failedClips.insert(clipKey);
+    }
+
+    // Hand the first frame to every view that was waiting for this clip
+    QList<Handle> delivered;
+    const qint64 now = m_clock.elapsed();
+    for (auto it = m_subscribers.begin(); it != m_subscribers.end(); ++it) {
+        if (it->key != clipKey || it->ready) {
+            continue;
+        }
+        it->ready = true;
+        it->clip = clip;
+        it->frame = 0;
+        if (clip) {
+            it->nextFrameAt = now + clip->delays.first();
+        }
+        delivered.append(it.key());
+
+        // Views asked to play while this was decoding give their slot back if it cannot animate
+        if (isStill(*it)) {
+            m_playing.removeOne(it.key());
+            m_waiting.removeOne(it.key());
+        }
+    }
+    promoteWaiting();
+    updateTimer();
+
+    // Callbacks may detach other handles, so look each one up again
+    for (Handle handle : delivered) {
+        auto it = m_subscribers.find(handle);
+        if (it == m_subscribers.end() || it->receiver.isNull() || !it->callback) {
+            continue;
+        }
+        FrameCallback callback = it->callback;
+        callback(clip ? clip->frames.first() : QPixmap());
+    }
+}
+
+void PreviewAnimator::onTick()
+{
+    if (m_playing.isEmpty()) {
+        m_timer.stop();
+        return;
+    }
+
+    QElapsedTimer tickTime;
+    tickTime.start();
+    const qint64 now = m_clock.elapsed();
+
+    // Views that did not fit into the last tick's budget go first this time
+    const QList<Handle> order = m_playing;
+    const int count = order.size();
+    const int start = m_nextPlaying % count;
+    int updates = 0;
+    int visited = 0;
+    for (; visited < count; ++visited) {
+        if (updates >= MAX_UPDATES_PER_TICK || tickTime.elapsed() >= TICK_BUDGET_MS) {
+            break;
+        }
+
+        auto it = m_subscribers.find(order.at((start + visited) % count));
+        if (it == m_subscribers.end() || !it->clip || it->clip->frames.size() < 2 || now < it->nextFrameAt) {
+            continue;
+        }
+
+        const ClipPtr clip = it->clip;
+        it->frame = (it->frame + 1) % clip->frames.size();
+        const int delay = clip->delays.at(it->frame);
+        // A view that fell far behind restarts its timing instead of racing to catch up
+        it->nextFrameAt = (now - it->nextFrameAt > delay) ? now + delay : it->nextFrameAt + delay;
+
+        if (it->receiver.isNull() || !it->callback) {
+            continue;
+        }
+        FrameCallback callback = it->callback;
+        updates++;
+        callback(clip->frames.at(it->frame));
+    }
+
+    m_nextPlaying = m_playing.isEmpty() ? 0 : (start + visited) % m_playing.size();
+}
@@ -0,0 +1,140 @@
+#ifndef PREVIEWANIMATOR_H
+#define PREVIEWANIMATOR_H
+
+#include <QObject>
+#include <QPixmap>
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include <QCache>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <functional>
+
+// Plays animated previews (GIF, animated WebP) for every view from one place.
+//
+// A clip is decoded once, on a worker thread, already scaled to the size it is shown
+// at, and kept in a byte-bounded LRU keyed by wallpaper id, source file (path and
+// mtime) and size, so the grid, the playlist and the properties panel showing the same
+// wallpaper share its frames, and a changed preview file is decoded afresh. All
+// playing views are advanced by a single timer that hands out at most a fixed number
+// of frame updates and a fixed slice of GUI-thread time per tick; views that miss a
+// tick are served first on the next one. Clips are limited to a tile-friendly frame
+// rate and, unless disabled, transcoded once into AnimationDiskCache so later runs
+// skip decoding the source GIF altogether. At most maxPlaying() handles advance at once;
+// further handles asked to play wait, showing their current frame, until a slot frees
+// up. Compared with a QMovie per tile this keeps a
+// page of GIFs from decoding full-size frames on the GUI thread over and over.
+class PreviewAnimator : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Handle = quint64;
+    using FrameCallback = std::function<void(const QPixmap& frame)>;
+
+    static PreviewAnimator& instance();
+
+    // Starts showing sourcePath scaled to fit targetSize. callback runs on the GUI thread
+    // with the first frame once the clip is decoded (a null pixmap if it cannot be), and
+    // with every following frame while the handle is playing. Handles start paused.
+    // A clip that already failed to decode yields handle 0, after callback has had a null pixmap
+    Handle attach(const QString& wallpaperId, const QString& sourcePath, const QSize& targetSize,
+                  QObject* receiver, FrameCallback callback);
+    void detach(Handle handle);
+
+    // isPlaying() reports what was asked for; a handle over the cap is playing but waiting
+    void setPlaying(Handle handle, bool playing);
+    bool isPlaying(Handle handle) const;
+    int playingCount() const { return m_playing.size(); }
+
+    void setMaxPlaying(int count);
+    int maxPlaying() const { return m_maxPlaying; }
+
+    // Applies to clips decoded from now on
+    void setTranscodeEnabled(bool enabled);
+
+private:
+    struct Clip {
+        QList<QPixmap> frames;
+        QList<int> delays;  // Milliseconds each frame stays on screen
+    };
+    using ClipPtr = QSharedPointer<const Clip>;
+
+    struct DecodedClip {
+        QList<QImage> frames;
+        QList<int> delays;
+    };
+
+    struct Subscriber {
+        QString key;
+        QPointer<QObject> receiver;
+        FrameCallback callback;
+        ClipPtr clip;           // Null while decoding, and after a failed decode
+        bool ready = false;     // Decode finished, successfully or not
+        bool playing = false;
+        int frame = 0;
+        qint64 nextFrameAt = 0; // On m_clock
+    };
+
+    // Cache entries hold a reference so eviction never pulls frames from under a view
+    struct CachedClip {
+        ClipPtr clip;
+    };
+
+    explicit PreviewAnimator(QObject* parent = nullptr);
+    ~PreviewAnimator();
+
+    static QString key(const QString& wallpaperId, const QString& sourcePath, const QSize& targetSize);
+    static DecodedClip decodeClip(const QString& sourcePath, const QSize& targetSize, bool transcode,
+                                  const QSharedPointer<QAtomicInt>& cancelled);
+    static DecodedClip decodeSource(const QString& sourcePath, const QSize& targetSize,
+                                    const QSharedPointer<QAtomicInt>& cancelled);
+    static void limitFrameRate(DecodedClip& clip);
+
+    void startDecode(const QString& clipKey, const QString& sourcePath, const QSize& targetSize);
+    void onClipDecoded(const QString& clipKey, const QSharedPointer<QAtomicInt>& cancelled,
+                       const DecodedClip& decoded);
+    void onTick();
+    void updateTimer();
+    void resume(Handle handle);
+    void promoteWaiting();
+    void detachReceiver(QObject* receiver);
+    // Decoded to nothing or a single frame: never needs a playing slot
+    static bool isStill(const Subscriber& subscriber);
+    // Joins the workers and drops every clip and handle; run when the application quits
+    void shutdown();
+
+    QThreadPool m_pool;
+    QCache<QString, CachedClip> m_clips;                      // Cost in KiB
+    QHash<QString, QSharedPointer<QAtomicInt>> m_decoding;     // Clip key -> cancellation flag
+    QSet<QString> m_failedClips;                              // Clip keys that decoded to nothing
+    QHash<Handle, Subscriber> m_subscribers;
+    QList<Handle> m_playing;                                  // Round-robin order for the frame budget
+    QList<Handle> m_waiting;                                  // Asked to play while m_playing was full
+    int m_nextPlaying;                                        // Where the next tick starts in m_playing
+    int m_maxPlaying;
+    bool m_transcode;                                         // Keep decoded clips in AnimationDiskCache
+    QSet<QObject*> m_trackedReceivers;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    Handle m_nextHandle;
+
+    static constexpr int TICK_MS = 20;                 // Finest frame timing the engine honours
+    static constexpr int MAX_UPDATES_PER_TICK = 12;    // Frame changes handed to views per tick
+    static constexpr int TICK_BUDGET_MS = 6;           // GUI-thread time per tick spent on callbacks
+    static constexpr int MIN_FRAME_DELAY_MS = 20;
+    static constexpr int MIN_PLAYBACK_DELAY_MS = 40;   // Faster frames are merged, tiles play at 25 fps at most
+    static constexpr int DEFAULT_FRAME_DELAY_MS = 100; // For 0-10 ms delays, as browsers do
+    static constexpr int MAX_FRAMES = 240;             // Longer clips are truncated
+    static constexpr qint64 MAX_CLIP_BYTES = 24 * 1024 * 1024;
+};
+
+#endif // PREVIEWANIMATOR_H
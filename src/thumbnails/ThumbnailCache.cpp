@@ -0,0 +1,93 @@
+#include "ThumbnailCache.h"
+#include "ConfigManager.h"
+#include <QCoreApplication>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(thumbnailCache, "app.thumbnailCache")
+
+ThumbnailCache& ThumbnailCache::instance()
+{
+    static ThumbnailCache instance;
+    return instance;
+}
+
+ThumbnailCache::ThumbnailCache()
+    : m_cache(qMax(8, ConfigManager::instance().thumbnailMemoryCacheMB()) * 1024)
+    , m_hits(0)
+    , m_misses(0)
+{
+    // Pixmaps must be released while the GUI application still exists, not at static destruction
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        QObject::connect(app, &QCoreApplication::aboutToQuit, app, [this]() { clear(); });
+    }
+}
+
+QString ThumbnailCache::key(const QString& wallpaperId, const QSize& size, qreal devicePixelRatio)
+{
+    return QString("%1@%2x%3@%4").arg(wallpaperId).arg(size.width()).arg(size.height()).arg(devicePixelRatio);
+}
+
+QPixmap ThumbnailCache::find(const QString& wallpaperId, const QSize& size, qreal devicePixelRatio,
+                             const QString& sourcePath)
+{
+    const QString cacheKey = key(wallpaperId, size, devicePixelRatio);
+    Entry* entry = m_cache.object(cacheKey);  // Moves the entry to the front of the LRU
+
+    QPixmap pixmap;
+    if (entry && entry->sourcePath == sourcePath) {
+        pixmap = entry->pixmap;
+        m_hits++;
+    } else {
+        if (entry) {
+            m_cache.remove(cacheKey);  // The wallpaper's preview file changed
+        }
+        m_misses++;
+    }
+
+    if ((m_hits + m_misses) % STATS_LOG_INTERVAL == 0) {
+        qCDebug(thumbnailCache) << "Thumbnail cache:" << m_hits << "hits," << m_misses << "misses,"
+                                << usedBytes() / 1024 << "of" << budgetBytes() / 1024 << "KiB used";
+    }
+    return pixmap;
+}
+
+void ThumbnailCache::insert(const QString& wallpaperId, const QSize& size, qreal devicePixelRatio,
+                            const QString& sourcePath, qint64 sourceModified, const QPixmap& pixmap)
+{
+    if (wallpaperId.isEmpty() || pixmap.isNull()) {
+        return;
+    }
+
+    const qint64 bytes = qint64(pixmap.width()) * pixmap.height() * qMax(1, pixmap.depth() / 8);
+    const int cost = int(qMax<qint64>(1, bytes / 1024));
+
+    Entry* entry = new Entry;
+    entry->pixmap = pixmap;
+    entry->wallpaperId = wallpaperId;
+    entry->sourcePath = sourcePath;
+    entry->sourceModified = sourceModified;
+    // QCache deletes the entry itself if it is larger than the whole budget
+    m_cache.insert(key(wallpaperId, size, devicePixelRatio), entry, cost);
+}
+
+void ThumbnailCache::removeStale(const QString& wallpaperId, const QString& sourcePath, qint64 sourceModified)
+{
+    // Only runs when the library reports a changed preview, so a pass over the keys is fine
+    const QString prefix = wallpaperId + QLatin1Char('@');
+    const QList<QString> keys = m_cache.keys();
+    for (const QString& cacheKey : keys) {
+        if (!cacheKey.startsWith(prefix)) {
+            continue;
+        }
+        const Entry* entry = m_cache.object(cacheKey);
+        if (entry && entry->wallpaperId == wallpaperId
+            && (entry->sourcePath != sourcePath || entry->sourceModified != sourceModified)) {
+            m_cache.remove(cacheKey);
+        }
+    }
+}
+
+void ThumbnailCache::clear()
+{
+    m_cache.clear();
+}
@@ -0,0 +1,56 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QString>
+#include <QPixmap>
+#include <QSize>
+#include <QCache>
+
+// Process-wide LRU of decoded thumbnails, shared by the grid, the playlist, the screen
+// pictograms and the properties panel. Keyed by wallpaper id, display size and device
+// pixel ratio, so a window spanning a 100% and a 200% screen keeps a sharp variant for
+// each; the source path and mtime are stored with each entry so a wallpaper whose preview
+// file moved misses, and one rewritten in place can be dropped with removeStale() instead
+// of showing the old image. Bounded by a byte budget rather than a
+// count because sizes differ between views. Emptied on aboutToQuit, as the singleton
+// itself outlives QApplication. GUI thread only (QPixmap).
+class ThumbnailCache
+{
+public:
+    static ThumbnailCache& instance();
+
+    // Null pixmap on a miss
+    QPixmap find(const QString& wallpaperId, const QSize& size, qreal devicePixelRatio, const QString& sourcePath);
+    void insert(const QString& wallpaperId, const QSize& size, qreal devicePixelRatio, const QString& sourcePath,
+                qint64 sourceModified, const QPixmap& pixmap);
+    // Drops every entry of the wallpaper not decoded from this version of sourcePath
+    void removeStale(const QString& wallpaperId, const QString& sourcePath, qint64 sourceModified);
+    void clear();
+
+    qint64 hits() const { return m_hits; }
+    qint64 misses() const { return m_misses; }
+    qint64 usedBytes() const { return qint64(m_cache.totalCost()) * 1024; }
+    qint64 budgetBytes() const { return qint64(m_cache.maxCost()) * 1024; }
+
+private:
+    ThumbnailCache();
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    static QString key(const QString& wallpaperId, const QSize& size, qreal devicePixelRatio);
+
+    struct Entry {
+        QPixmap pixmap;
+        QString wallpaperId;
+        QString sourcePath;
+        qint64 sourceModified;
+    };
+
+    QCache<QString, Entry> m_cache;  // Cost is in KiB so large budgets fit in an int
+    qint64 m_hits;
+    qint64 m_misses;
+
+    static constexpr int STATS_LOG_INTERVAL = 500;  // Lookups between debug statistics lines
+};
+
+#endif // THUMBNAILCACHE_H
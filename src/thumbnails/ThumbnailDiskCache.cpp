@@ -0,0 +1,64 @@
+#include "ThumbnailDiskCache.h"
+#include "ConfigManager.h"
+#include <QBuffer>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(thumbnailDiskCache, "app.thumbnailDiskCache")
+
+ThumbnailDiskCache& ThumbnailDiskCache::instance()
+{
+    static ThumbnailDiskCache instance;
+    return instance;
+}
+
+ThumbnailDiskCache::ThumbnailDiskCache()
+    : m_directory("thumbnails", qint64(qMax(16, ConfigManager::instance().thumbnailCacheSizeMB())) * 1024 * 1024,
+                  TRIM_INTERVAL)
+{
+}
+
+QImage ThumbnailDiskCache::load(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize,
+                                const QSize& targetSize)
+{
+    const QString path = m_directory.entryPath(sourcePath, sourceModified, sourceSize, targetSize);
+    QByteArray data = m_directory.read(path);
+    if (data.isEmpty()) {
+        return QImage();
+    }
+
+    // Entries have no suffix, the reader picks JPEG or PNG from the content
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qCDebug(thumbnailDiskCache) << "Cannot decode thumbnail for" << sourcePath << reader.errorString();
+        m_directory.remove(path);
+    }
+    return image;
+}
+
+void ThumbnailDiskCache::store(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize,
+                               const QSize& targetSize, const QImage& image)
+{
+    if (image.isNull()) {
+        return;
+    }
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    const QByteArray format = image.hasAlphaChannel() ? "png" : "jpg";
+    QImageWriter writer(&buffer, format);
+    if (format == "jpg") {
+        writer.setQuality(JPEG_QUALITY);
+    }
+    if (!writer.write(image)) {
+        qCDebug(thumbnailDiskCache) << "Failed to encode thumbnail for" << sourcePath << writer.errorString();
+        return;
+    }
+
+    m_directory.write(m_directory.entryPath(sourcePath, sourceModified, sourceSize, targetSize), data);
+}
@@ -0,0 +1,41 @@
+#ifndef THUMBNAILDISKCACHE_H
+#define THUMBNAILDISKCACHE_H
+
+#include <QString>
+#include <QImage>
+#include <QSize>
+#include "DiskCacheDirectory.h"
+
+// Persistent cache of decoded thumbnails at the size they are displayed at.
+//
+// Entries live in a DiskCacheDirectory, so they are content addressed and an updated
+// preview simply misses. Opaque thumbnails are stored as JPEG, ones with alpha as PNG;
+// both decode in well under a millisecond at tile size. All methods may be called from
+// worker threads.
+class ThumbnailDiskCache
+{
+public:
+    static ThumbnailDiskCache& instance();
+
+    QImage load(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize, const QSize& targetSize);
+    void store(const QString& sourcePath, qint64 sourceModified, qint64 sourceSize, const QSize& targetSize,
+               const QImage& image);
+
+    QString cacheDir() const { return m_directory.path(); }
+    qint64 maxBytes() const { return m_directory.maxBytes(); }
+
+    // Drops least recently used entries until the cache is below its cap
+    void trim() { m_directory.trim(); }
+
+private:
+    ThumbnailDiskCache();
+    ThumbnailDiskCache(const ThumbnailDiskCache&) = delete;
+    ThumbnailDiskCache& operator=(const ThumbnailDiskCache&) = delete;
+
+    DiskCacheDirectory m_directory;
+
+    static constexpr int TRIM_INTERVAL = 64;  // Re-measure the directory every so many writes
+    static constexpr int JPEG_QUALITY = 90;
+};
+
+#endif // THUMBNAILDISKCACHE_H
@@ -0,0 +1,212 @@
+#include "ThumbnailLoader.h"
+#include "ThumbnailDiskCache.h"
+#include "ThumbnailCache.h"
+#include <QImageReader>
+#include <QFileInfo>
+#include <QThread>
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <QtMath>
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(thumbnailLoader, "app.thumbnailLoader")
+
+ThumbnailLoader& ThumbnailLoader::instance()
+{
+    static ThumbnailLoader instance;
+    return instance;
+}
+
+ThumbnailLoader::ThumbnailLoader(QObject* parent)
+    : QObject(parent)
+    , m_nextTicket(1)
+{
+    // Leave cores for the GUI thread and the library scan
+    m_pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount() / 2));
+    m_pool.setObjectName("ThumbnailPool");
+
+    // Created here so it reads its settings on the GUI thread, not from a worker
+    ThumbnailDiskCache::instance();
+
+    // The singleton itself outlives QApplication; its workers must not
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, this, &ThumbnailLoader::shutdown);
+    }
+}
+
+ThumbnailLoader::~ThumbnailLoader()
+{
+    shutdown();
+}
+
+void ThumbnailLoader::shutdown()
+{
+    for (const Job& job : std::as_const(m_jobs)) {
+        job.cancelled->storeRelaxed(1);
+    }
+    m_jobs.clear();
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QSize ThumbnailLoader::pixelSize(const QSize& size, qreal devicePixelRatio)
+{
+    return QSize(qCeil(size.width() * devicePixelRatio), qCeil(size.height() * devicePixelRatio));
+}
+
+ThumbnailLoader::Ticket ThumbnailLoader::request(const QString& wallpaperId, const QString& sourcePath,
+                                                 const QSize& targetSize, qreal devicePixelRatio,
+                                                 QObject* receiver, Callback callback, Priority priority)
+{
+    const QPixmap cached = ThumbnailCache::instance().find(wallpaperId, targetSize, devicePixelRatio, sourcePath);
+    if (!cached.isNull()) {
+        if (callback) {
+            callback(cached);
+        }
+        return 0;
+    }
+
+    const Ticket ticket = m_nextTicket++;
+
+    Job job;
+    job.wallpaperId = wallpaperId;
+    job.sourcePath = sourcePath;
+    job.targetSize = targetSize;
+    job.devicePixelRatio = devicePixelRatio;
+    job.receiver = receiver;
+    job.callback = std::move(callback);
+    job.cancelled = QSharedPointer<QAtomicInt>::create(0);
+    m_jobs.insert(ticket, job);
+
+    // Tiles are deleted with deleteLater() when a page is cleared; their work goes with them
+    if (receiver && !m_trackedReceivers.contains(receiver)) {
+        m_trackedReceivers.insert(receiver);
+        connect(receiver, &QObject::destroyed, this, [this](QObject* object) {
+            m_trackedReceivers.remove(object);
+            cancelForReceiver(object);
+        });
+    }
+
+    QSharedPointer<QAtomicInt> cancelled = job.cancelled;
+    const QSize decodeSize = pixelSize(targetSize, devicePixelRatio);
+    m_pool.start([this, ticket, sourcePath, decodeSize, cancelled]() {
+        if (cancelled->loadRelaxed()) {
+            return;
+        }
+        qint64 sourceModified = 0;
+        QImage image = decode(sourcePath, decodeSize, &sourceModified);
+        if (cancelled->loadRelaxed()) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this, ticket, image, sourceModified]() {
+            onDecoded(ticket, image, sourceModified);
+        }, Qt::QueuedConnection);
+    }, priority);
+
+    return ticket;
+}
+
+void ThumbnailLoader::cancel(Ticket ticket)
+{
+    auto it = m_jobs.find(ticket);
+    if (it == m_jobs.end()) {
+        return;
+    }
+    it->cancelled->storeRelaxed(1);
+    m_jobs.erase(it);
+}
+
+void ThumbnailLoader::invalidate(const QString& wallpaperId, const QString& sourcePath)
+{
+    // The path alone does not change when an update rewrites preview.jpg in place
+    const qint64 modified = QFileInfo(sourcePath).lastModified().toMSecsSinceEpoch();
+    m_previewModified.insert(wallpaperId, modified);
+    ThumbnailCache::instance().removeStale(wallpaperId, sourcePath, modified);
+}
+
+void ThumbnailLoader::cancelForReceiver(QObject* receiver)
+{
+    for (auto it = m_jobs.begin(); it != m_jobs.end();) {
+        // The QPointer is already null once destroyed() fires, so compare the raw pointer too
+        if (it->receiver.isNull() || it->receiver.data() == receiver) {
+            it->cancelled->storeRelaxed(1);
+            it = m_jobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ThumbnailLoader::onDecoded(Ticket ticket, const QImage& image, qint64 sourceModified)
+{
+    auto it = m_jobs.find(ticket);
+    if (it == m_jobs.end()) {
+        return; // Cancelled after the worker had already finished
+    }
+    Job job = *it;
+    m_jobs.erase(it);
+
+    // Converted once here; every view showing this wallpaper at this size shares the pixmap
+    QPixmap pixmap = QPixmap::fromImage(image);
+    pixmap.setDevicePixelRatio(job.devicePixelRatio);
+    // A decode of the file as it was before the last invalidate() must not refill the cache
+    const auto known = m_previewModified.constFind(job.wallpaperId);
+    if (known == m_previewModified.cend() || known.value() == sourceModified) {
+        ThumbnailCache::instance().insert(job.wallpaperId, job.targetSize, job.devicePixelRatio, job.sourcePath,
+                                          sourceModified, pixmap);
+    }
+
+    if (job.receiver.isNull() || !job.callback) {
+        return;
+    }
+    job.callback(pixmap);
+}
+
+QImage ThumbnailLoader::decode(const QString& sourcePath, const QSize& targetSize, qint64* sourceModified)
+{
+    const QFileInfo sourceInfo(sourcePath);
+    if (!sourceInfo.isFile()) {
+        return QImage();
+    }
+    const qint64 modified = sourceInfo.lastModified().toMSecsSinceEpoch();
+    if (sourceModified) {
+        *sourceModified = modified;
+    }
+
+    // After the first run a page is a handful of small cache reads
+    ThumbnailDiskCache& diskCache = ThumbnailDiskCache::instance();
+    QImage image = diskCache.load(sourcePath, modified, sourceInfo.size(), targetSize);
+    if (!image.isNull()) {
+        return image;
+    }
+
+    image = decodeSource(sourcePath, targetSize);
+    diskCache.store(sourcePath, modified, sourceInfo.size(), targetSize, image);
+    return image;
+}
+
+QImage ThumbnailLoader::decodeSource(const QString& sourcePath, const QSize& targetSize)
+{
+    QImageReader reader(sourcePath);
+    reader.setAutoTransform(true);
+
+    const QSize sourceSize = reader.size();
+    const bool canScale = sourceSize.isValid() && targetSize.isValid()
+        && reader.supportsOption(QImageIOHandler::ScaledSize);
+    if (canScale && (sourceSize.width() > targetSize.width() || sourceSize.height() > targetSize.height())) {
+        // The JPEG handler decodes straight into the smaller size
+        reader.setScaledSize(sourceSize.scaled(targetSize, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qCDebug(thumbnailLoader) << "Failed to decode" << sourcePath << reader.errorString();
+        return image;
+    }
+
+    // Formats without scaled decoding (and EXIF-rotated ones) are scaled here, still off the GUI thread
+    if (targetSize.isValid() && (image.width() > targetSize.width() || image.height() > targetSize.height())) {
+        image = image.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
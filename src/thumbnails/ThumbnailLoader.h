@@ -0,0 +1,99 @@
+#ifndef THUMBNAILLOADER_H
+#define THUMBNAILLOADER_H
+
+#include <QObject>
+#include <QImage>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <functional>
+
+// Decodes preview images off the GUI thread, already scaled to the size they are shown at.
+//
+// QImageReader::setScaledSize() lets JPEG previews decode at a fraction of their size
+// instead of loading a 1920px image and scaling it down afterwards. Finished images are
+// handed to the requester's callback on the GUI thread. A request is dropped as soon as
+// it is cancelled or its receiver is destroyed, whether it is still queued or running.
+// Results are kept in ThumbnailCache, so views showing the same wallpaper at the same
+// size share one decode.
+//
+// Sizes are logical; every request also carries the device pixel ratio of the screen
+// the view is on. The image is decoded at that many physical pixels and tagged with the
+// ratio, so tiles on a 200% screen are sharp instead of upscaled. Each ratio is its own
+// entry in both caches: a window moved back to a screen it was on before is served
+// from memory or disk without touching the source again.
+class ThumbnailLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Ticket = quint64;
+    using Callback = std::function<void(const QPixmap& pixmap)>;
+
+    enum Priority {
+        LowPriority = 0,     // Speculative work, e.g. pages the user may flip to
+        NormalPriority = 1,  // Anything currently on screen
+    };
+
+    static ThumbnailLoader& instance();
+
+    // Size the grid and playlist tiles request, so other views can reuse their entries
+    static QSize tileSize() { return QSize(256, 144); }
+
+    // Physical pixels a view of the given logical size covers at devicePixelRatio
+    static QSize pixelSize(const QSize& size, qreal devicePixelRatio);
+
+    // Queues a decode of sourcePath to fit inside targetSize (aspect ratio kept) at
+    // devicePixelRatio. callback runs on the GUI thread with a null pixmap if the file
+    // could not be read. A memory cache hit invokes callback before returning and yields
+    // ticket 0.
+    Ticket request(const QString& wallpaperId, const QString& sourcePath, const QSize& targetSize,
+                   qreal devicePixelRatio, QObject* receiver, Callback callback,
+                   Priority priority = NormalPriority);
+    void cancel(Ticket ticket);
+
+    // For a wallpaper whose preview changed: drops cached thumbnails decoded from an older
+    // version of sourcePath, and keeps decodes of one still running out of the cache.
+    // Cheap to call again for the same change, so every view can do so before re-requesting
+    void invalidate(const QString& wallpaperId, const QString& sourcePath);
+
+    // Synchronous decode used by the workers, served from ThumbnailDiskCache when possible;
+    // targetSize is in physical pixels here. sourceModified, if given, receives the mtime of
+    // the file that was read. Safe to call from any thread
+    static QImage decode(const QString& sourcePath, const QSize& targetSize, qint64* sourceModified = nullptr);
+
+private:
+    static QImage decodeSource(const QString& sourcePath, const QSize& targetSize);
+
+    explicit ThumbnailLoader(QObject* parent = nullptr);
+    ~ThumbnailLoader();
+
+    void onDecoded(Ticket ticket, const QImage& image, qint64 sourceModified);
+    void cancelForReceiver(QObject* receiver);
+    // Drops every job and joins the workers; run when the application quits
+    void shutdown();
+
+    struct Job {
+        QString wallpaperId;
+        QString sourcePath;
+        QSize targetSize;
+        qreal devicePixelRatio;
+        QPointer<QObject> receiver;
+        Callback callback;
+        QSharedPointer<QAtomicInt> cancelled;
+    };
+
+    QThreadPool m_pool;
+    QHash<Ticket, Job> m_jobs;
+    QSet<QObject*> m_trackedReceivers;  // Receivers whose destroyed() is already connected
+    QHash<QString, qint64> m_previewModified;  // Wallpaper id -> preview mtime at the last invalidate()
+    Ticket m_nextTicket;
+};
+
+#endif // THUMBNAILLOADER_H
@@ -9,6 +9,7 @@
 #include "../core/WallpaperManager.h"
 #include "../steam/SteamDetector.h"
 #include "../addons/WNELAddon.h"  // Add WNEL addon include
+#include "../thumbnails/PreviewAnimator.h"
 #include <QApplication>
 #include <QSplitter>
 #include <QVBoxLayout>
@@ -1129,6 +1130,12 @@ void MainWindow::openSettings()
         // Update multi-monitor UI in case mode was changed
         updateMultiMonitorUI();
         
+        if (m_wallpaperPreview) {
+            m_wallpaperPreview->setVirtualizedGridEnabled(m_config.virtualizedGridEnabled());
+        }
+        PreviewAnimator::instance().setMaxPlaying(m_config.maxPreviewAnimations());
+        PreviewAnimator::instance().setTranscodeEnabled(m_config.transcodeAnimatedPreviews());
+        
         bool isConfigValid = m_config.isConfigurationValid();
         
         if (!wasConfigValid && isConfigValid) {
@@ -1221,11 +1228,8 @@ void MainWindow::onRefreshFinished()
     // Reset status bar styling
     m_statusLabel->setStyleSheet("");
     
-    // Update wallpaper preview 
-    auto wallpapers = m_wallpaperManager->getAllWallpapers();
-    
     // Update wallpaper count display
-    int count = wallpapers.size();
+    int count = m_wallpaperManager->wallpaperCount();
     m_wallpaperCountLabel->setText(QString("%1 wallpapers").arg(count));
     
     if (count > 0) {
@@ -1274,9 +1278,9 @@ void MainWindow::onRefreshFinished()
                             // Get wallpaper info and preview
                             auto wallpaperInfo = m_wallpaperManager->getWallpaperInfo(wallpaperId);
                             if (wallpaperInfo.has_value()) {
-                                QPixmap preview = QPixmap(wallpaperInfo->previewPath);
+                                const QString previewPath = wallpaperInfo->previewPath;
                                 m_screenSelectionWidget->setScreenWallpaper(technicalName, wallpaperId, 
-                                                                             wallpaperInfo->name, preview);
+                                                                             wallpaperInfo->name, previewPath);
                             }
                         }
                     }
@@ -1384,9 +1388,9 @@ void MainWindow::onWallpaperSelected(const WallpaperInfo& wallpaper)
             if (m_config.multiMonitorModeEnabled() && m_screenSelectionWidget) {
                 QString selectedScreen = m_screenSelectionWidget->getSelectedScreen();
                 if (!selectedScreen.isEmpty()) {
-                    QPixmap preview = QPixmap(wallpaper.previewPath);
+                    const QString previewPath = wallpaper.previewPath;
                     m_screenSelectionWidget->setScreenWallpaper(selectedScreen, wallpaper.id, 
-                                                                 wallpaper.name, preview);
+                                                                 wallpaper.name, previewPath);
                     
                     // Save assignment to config
                     QMap<QString, QString> currentAssignments = m_config.multiMonitorScreenAssignments();
@@ -2353,9 +2357,9 @@ void MainWindow::updateMultiMonitorUI()
                 if (m_wallpaperManager) {
                     auto wallpaperInfo = m_wallpaperManager->getWallpaperInfo(wallpaperId);
                     if (wallpaperInfo.has_value()) {
-                        QPixmap preview = QPixmap(wallpaperInfo->previewPath);
+                        const QString previewPath = wallpaperInfo->previewPath;
                         m_screenSelectionWidget->setScreenWallpaper(technicalName, wallpaperId, 
-                                                                     wallpaperInfo->name, preview);
+                                                                     wallpaperInfo->name, previewPath);
                         continue;
                     }
                 }
@@ -2365,9 +2369,9 @@ void MainWindow::updateMultiMonitorUI()
                     QList<ExternalWallpaperInfo> externalWallpapers = m_wnelAddon->getAllExternalWallpapers();
                     for (const ExternalWallpaperInfo& external : externalWallpapers) {
                         if (external.id == wallpaperId) {
-                            QPixmap preview = QPixmap(external.previewPath);
+                            const QString previewPath = external.previewPath;
                             m_screenSelectionWidget->setScreenWallpaper(technicalName, wallpaperId, 
-                                                                         external.name, preview);
+                                                                         external.name, previewPath);
                             break;
                         }
                     }
@@ -2468,10 +2472,10 @@ void MainWindow::onMultiMonitorApply()
             if (m_wallpaperManager) {
                 auto wallpaperInfo = m_wallpaperManager->getWallpaperInfo(wallpaperId);
                 if (wallpaperInfo.has_value()) {
-                    QPixmap preview = QPixmap(wallpaperInfo->previewPath);
+                    const QString previewPath = wallpaperInfo->previewPath;
                     for (const QString& screen : screenOrder) {
                         m_screenSelectionWidget->setScreenWallpaper(screen, wallpaperId, 
-                                                                     wallpaperInfo->name, preview);
+                                                                     wallpaperInfo->name, previewPath);
                     }
                 }
             }
@@ -1,6 +1,8 @@
 #include "PropertiesPanel.h"
 #include "../core/ConfigManager.h"
 #include "../steam/SteamApiManager.h"
+#include "../thumbnails/ThumbnailLoader.h"
+#include "../thumbnails/PreviewAnimator.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -32,6 +34,8 @@
 #include <QMouseEvent>
 #include <QClipboard>
 #include <QTimer>
+#include <QFileInfo>
+#include <QMetaObject>
 
 Q_LOGGING_CATEGORY(propertiesPanel, "app.propertiespanel")
 
@@ -161,7 +165,8 @@ PropertiesPanel::PropertiesPanel(QWidget* parent)
     , m_currentWallpaper()
     , m_currentSettings()
     , m_wallpaperManager(nullptr)
-    , m_previewMovie(nullptr)
+    , m_animationHandle(0)
+    , m_previewTicket(0)
     , m_propertyWidgets()
     , m_originalValues()
     , m_originalPropertyObjects()
@@ -228,6 +233,17 @@ PropertiesPanel::PropertiesPanel(QWidget* parent)
             this, &PropertiesPanel::onUserProfileReceived);
     connect(&SteamApiManager::instance(), &SteamApiManager::itemDetailsReceived,
             this, &PropertiesPanel::onApiMetadataReceived);
+    
+    // One reader is enough: only the latest selection matters, older ones are dropped
+    m_selectionPool.setMaxThreadCount(1);
+    m_selectionPool.setObjectName("SelectionPool");
+}
+
+PropertiesPanel::~PropertiesPanel()
+{
+    cancelSelectionLoading();
+    m_selectionPool.clear();
+    m_selectionPool.waitForDone();
 }
 
 void PropertiesPanel::setupUI()
@@ -477,6 +493,7 @@ void PropertiesPanel::setupSettingsUI(QWidget* settingsTab)
     auto* scrollLayout = new QVBoxLayout(scrollWidget);
     scrollLayout->setContentsMargins(16, 16, 16, 16);
     scrollLayout->setSpacing(20);
+    m_settingsWidget = scrollWidget;
     
     // Add "Use Global Defaults" checkbox at the top
     auto* globalDefaultsGroup = new QGroupBox("Settings Mode");
@@ -877,7 +894,8 @@ void PropertiesPanel::setWallpaper(const WallpaperInfo& wallpaper)
     // Update basic info
     m_nameLabel->setText(wallpaper.name.isEmpty() ? "Unknown" : wallpaper.name);
     m_typeLabel->setText(wallpaper.type.isEmpty() ? "Unknown" : wallpaper.type);
-    m_fileSizeLabel->setText(formatFileSize(wallpaper.fileSize));
+    // Library sizes are measured in the background and arrive through wallpaperUpdated()
+    m_fileSizeLabel->setText(wallpaper.fileSize > 0 ? formatFileSize(wallpaper.fileSize) : "Calculating...");
     
     if (!isExternalWallpaper) {
         // Steam-specific data only for regular wallpapers
@@ -907,75 +925,204 @@ void PropertiesPanel::setWallpaper(const WallpaperInfo& wallpaper)
         m_descriptionEdit->setText("No description available.");
     }
     
-    // Update preview
+    // Preview, properties and settings come from disk and are filled in as they arrive,
+    // so a click only ever waits for the labels above
     updatePreview(wallpaper);
-    
-    // Update properties - reload fresh from project.json file to get any saved changes
-    QJsonObject freshProperties = loadPropertiesFromProjectJson(wallpaper.id);
-    if (!freshProperties.isEmpty()) {
-        updateProperties(freshProperties);
-    } else {
-        // Fallback to cached properties if reading from file fails
-        updateProperties(wallpaper.properties);
-    }
-    
-    // Load and update settings for this wallpaper
-    loadWallpaperSettings(wallpaper.id);
+    loadSelectionAsync(wallpaper);
     
     // Enable launch button
     m_launchButton->setEnabled(!wallpaper.id.isEmpty());
     
-    // Check if backup exists to enable/disable reset button
-    QString backupPath = getBackupProjectJsonPath(wallpaper.id);
-    m_resetPropertiesButton->setEnabled(!wallpaper.id.isEmpty() && QFileInfo::exists(backupPath));
-    
     // Fetch Steam API metadata if available
     updateSteamApiMetadata(wallpaper);
     
     qCDebug(propertiesPanel) << "setWallpaper completed for:" << wallpaper.name;
 }
 
+void PropertiesPanel::loadSelectionAsync(const WallpaperInfo& wallpaper)
+{
+    cancelSelectionLoading();
+    
+    // Paths are resolved here, the worker only touches the files
+    const QString projectPath = getProjectJsonPath(wallpaper.id);
+    const QString backupPath = getBackupProjectJsonPath(wallpaper.id);
+    const QString settingsPath = getSettingsFilePath(wallpaper.id);
+    
+    // The previous wallpaper's properties and settings stay visible but inert until the
+    // new ones arrive, so nothing shown for the old wallpaper can be saved to the new one
+    m_scrollArea->setEnabled(false);
+    m_savePropertiesButton->setEnabled(false);
+    m_resetPropertiesButton->setEnabled(false);
+    m_settingsWidget->setEnabled(false);
+    m_saveSettingsButton->setEnabled(false);
+    
+    QSharedPointer<QAtomicInt> cancelled = QSharedPointer<QAtomicInt>::create(0);
+    m_selectionCancelled = cancelled;
+    m_selectionPool.start([this, wallpaper, projectPath, backupPath, settingsPath, cancelled]() {
+        if (cancelled->loadRelaxed()) {
+            return;
+        }
+        SelectionData data;
+        if (!projectPath.isEmpty()) {
+            data.properties = readProjectProperties(projectPath);
+        }
+        data.settings = readSettingsDocument(settingsPath);
+        data.hasBackup = !backupPath.isEmpty() && QFileInfo::exists(backupPath);
+        if (cancelled->loadRelaxed()) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this, wallpaper, data, cancelled]() {
+            if (cancelled->loadRelaxed()) {
+                return;  // Another wallpaper was selected while this one was read
+            }
+            m_selectionCancelled.reset();
+            applySelectionData(wallpaper, data);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void PropertiesPanel::applySelectionData(const WallpaperInfo& wallpaper, const SelectionData& data)
+{
+    // Fresh from project.json to get any saved changes, else the library's copy
+    if (!data.properties.isEmpty()) {
+        updateProperties(data.properties, data.hasBackup);
+    } else if (wallpaper.properties.isEmpty() && m_wallpaperManager) {
+        updateProperties(m_wallpaperManager->getWallpaperProperties(wallpaper.id), data.hasBackup);
+    } else {
+        updateProperties(wallpaper.properties, data.hasBackup);
+    }
+    m_scrollArea->setEnabled(true);
+    
+    applyWallpaperSettings(data.settings);
+    m_settingsModified = false;
+    m_saveSettingsButton->setEnabled(false);
+    m_settingsWidget->setEnabled(true);
+    
+    m_resetPropertiesButton->setEnabled(!wallpaper.id.isEmpty() && data.hasBackup);
+    qCDebug(propertiesPanel) << "Selection data applied for:" << wallpaper.name;
+}
+
+void PropertiesPanel::cancelSelectionLoading()
+{
+    if (m_selectionCancelled) {
+        m_selectionCancelled->storeRelaxed(1);
+        m_selectionCancelled.reset();
+    }
+}
+
 void PropertiesPanel::setWallpaperManager(WallpaperManager* manager)
 {
     m_wallpaperManager = manager;
+    
+    if (m_wallpaperManager) {
+        connect(m_wallpaperManager, &WallpaperManager::wallpaperUpdated,
+                this, &PropertiesPanel::onLibraryWallpaperUpdated);
+        connect(m_wallpaperManager, &WallpaperManager::wallpapersRemoved,
+                this, &PropertiesPanel::onLibraryWallpapersRemoved);
+    }
+}
+
+void PropertiesPanel::onLibraryWallpaperUpdated(const QString& wallpaperId, WallpaperInfo::Fields changed)
+{
+    if (!m_wallpaperManager || m_currentWallpaper.id.isEmpty() || m_currentWallpaper.id != wallpaperId) {
+        return;
+    }
+    
+    WallpaperInfo wallpaper = m_wallpaperManager->getWallpaperById(wallpaperId);
+    if (wallpaper.id.isEmpty()) {
+        return;
+    }
+    
+    qCDebug(propertiesPanel) << "Current wallpaper changed on disk, patching panel:" << wallpaperId;
+    m_currentWallpaper = wallpaper;
+    
+    if (changed & WallpaperInfo::NameField) {
+        m_nameLabel->setText(wallpaper.name.isEmpty() ? "Unknown" : wallpaper.name);
+    }
+    if (changed & WallpaperInfo::AuthorField) {
+        m_authorLabel->setText(wallpaper.author.isEmpty() ? "Unknown" : wallpaper.author);
+    }
+    if (changed & WallpaperInfo::TypeField) {
+        m_typeLabel->setText(wallpaper.type.isEmpty() ? "Unknown" : wallpaper.type);
+    }
+    if (changed & WallpaperInfo::FileSizeField) {
+        m_fileSizeLabel->setText(formatFileSize(wallpaper.fileSize));
+    }
+    if (changed & WallpaperInfo::DatesField) {
+        m_postedLabel->setText(wallpaper.created.isValid() ? wallpaper.created.toString("yyyy-MM-dd") : "Unknown");
+        m_updatedLabel->setText(wallpaper.updated.isValid() ? wallpaper.updated.toString("yyyy-MM-dd") : "Unknown");
+    }
+    if (changed & WallpaperInfo::DescriptionField) {
+        m_descriptionEdit->setText(wallpaper.description.isEmpty() ? "No description available." : wallpaper.description);
+    }
+    if (changed & WallpaperInfo::PreviewField) {
+        ThumbnailLoader::instance().invalidate(wallpaper.id, wallpaper.previewPath);
+        updatePreview(wallpaper);
+    }
+    
+    // Never throw away edits the user has not saved yet
+    if ((changed & WallpaperInfo::PropertiesField) && !m_propertiesModified) {
+        QJsonObject freshProperties = loadPropertiesFromProjectJson(wallpaperId);
+        if (!freshProperties.isEmpty()) {
+            updateProperties(freshProperties);
+        }
+    }
+}
+
+void PropertiesPanel::onLibraryWallpapersRemoved(const QStringList& wallpaperIds)
+{
+    if (m_currentWallpaper.id.isEmpty() || !wallpaperIds.contains(m_currentWallpaper.id)) {
+        return;
+    }
+    
+    qCInfo(propertiesPanel) << "Current wallpaper was removed from the library:" << m_currentWallpaper.id;
+    clear();
 }
 
 void PropertiesPanel::updatePreview(const WallpaperInfo& wallpaper)
 {
     qCDebug(propertiesPanel) << "updatePreview called for preview path:" << wallpaper.previewPath;
     
-    // Stop any existing animation first
+    // Stop any existing animation or pending decode first
     stopPreviewAnimation();
+    cancelPreviewLoading();
     
     if (!wallpaper.previewPath.isEmpty() && QFileInfo::exists(wallpaper.previewPath)) {
         // Check if it's an animated preview first
         if (hasAnimatedPreview(wallpaper.previewPath)) {
-            loadAnimatedPreview(wallpaper.previewPath);
+            loadAnimatedPreview(wallpaper.id, wallpaper.previewPath);
             return;
         }
         
-        // Load static image
-        QPixmap originalPixmap(wallpaper.previewPath);
+        QSize labelSize = m_previewLabel->size();
+        if (labelSize.width() < 50 || labelSize.height() < 50) {
+            labelSize = QSize(256, 144); // Use default size if label isn't sized yet
+        }
         
-        if (!originalPixmap.isNull()) {
-            qCDebug(propertiesPanel) << "Loaded preview image, original size:" 
-                                    << originalPixmap.width() << "x" << originalPixmap.height();
-            
-            // Scale the image properly while maintaining aspect ratio
-            QSize labelSize = m_previewLabel->size();
-            if (labelSize.width() < 50 || labelSize.height() < 50) {
-                labelSize = QSize(256, 144); // Use default size if label isn't sized yet
+        // Decoded at label size on a worker and kept in the shared thumbnail caches; the
+        // scan's dominant colour stands in meanwhile. A cache hit replaces it right away.
+        setPlaceholderPreview(wallpaper.placeholderColor != 0 ? QString() : "Loading preview...",
+                              wallpaper.placeholderColor);
+        
+        const QString wallpaperId = wallpaper.id;
+        const QString previewPath = wallpaper.previewPath;
+        m_previewTicket = ThumbnailLoader::instance().request(wallpaperId, previewPath, labelSize,
+                                                              m_previewLabel->devicePixelRatioF(), this,
+                                                              [this, wallpaperId, previewPath, labelSize](const QPixmap& pixmap) {
+            m_previewTicket = 0;
+            if (wallpaperId != m_currentWallpaper.id || previewPath != m_currentWallpaper.previewPath) {
+                return;
+            }
+            if (pixmap.isNull()) {
+                qCWarning(propertiesPanel) << "Failed to load preview image:" << previewPath;
+                setPlaceholderPreview("Failed to load preview");
+                return;
             }
             
-            QPixmap scaledPixmap = scalePixmapKeepAspectRatio(originalPixmap, labelSize);
-            m_previewLabel->setPixmap(scaledPixmap);
-            
-            qCDebug(propertiesPanel) << "Preview image set successfully, scaled to:" 
-                                    << scaledPixmap.width() << "x" << scaledPixmap.height();
-        } else {
-            qCWarning(propertiesPanel) << "Failed to load preview image:" << wallpaper.previewPath;
-            setPlaceholderPreview("Failed to load preview");
-        }
+            // Scale the image properly while maintaining aspect ratio
+            m_previewLabel->setPixmap(scalePixmapKeepAspectRatio(pixmap, labelSize));
+            qCDebug(propertiesPanel) << "Preview image set, size:" << pixmap.width() << "x" << pixmap.height();
+        });
     } else {
         qCDebug(propertiesPanel) << "No valid preview path, setting placeholder";
         setPlaceholderPreview("No preview available");
@@ -988,26 +1135,32 @@ QPixmap PropertiesPanel::scalePixmapKeepAspectRatio(const QPixmap& original, con
         return original;
     }
     
+    // Work in the pixels of the screen the original was made for; targetSize is logical
+    const qreal ratio = original.devicePixelRatio();
+    const QSize pixelTarget = ThumbnailLoader::pixelSize(targetSize, ratio);
+    
     // Calculate the best fit size while maintaining aspect ratio
     QSize originalSize = original.size();
-    QSize scaledSize = originalSize.scaled(targetSize, Qt::KeepAspectRatio);
+    QSize scaledSize = originalSize.scaled(pixelTarget, Qt::KeepAspectRatio);
     
     // Scale the pixmap
     QPixmap scaled = original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    scaled.setDevicePixelRatio(ratio);
     
     // Create a pixmap with the target size and center the scaled image
-    QPixmap result(targetSize);
+    QPixmap result(pixelTarget);
+    result.setDevicePixelRatio(ratio);
     result.fill(Qt::transparent);
     
     QPainter painter(&result);
-    int x = (targetSize.width() - scaled.width()) / 2;
-    int y = (targetSize.height() - scaled.height()) / 2;
-    painter.drawPixmap(x, y, scaled);
+    qreal x = (pixelTarget.width() - scaled.width()) / 2 / ratio;
+    qreal y = (pixelTarget.height() - scaled.height()) / 2 / ratio;
+    painter.drawPixmap(QPointF(x, y), scaled);
     
     return result;
 }
 
-void PropertiesPanel::setPlaceholderPreview(const QString& text)
+void PropertiesPanel::setPlaceholderPreview(const QString& text, QRgb background)
 {
     QSize labelSize = m_previewLabel->size();
     if (labelSize.width() < 50 || labelSize.height() < 50) {
@@ -1015,7 +1168,7 @@ void PropertiesPanel::setPlaceholderPreview(const QString& text)
     }
     
     QPixmap placeholder(labelSize);
-    placeholder.fill(QColor(245, 245, 245));
+    placeholder.fill(background != 0 ? QColor::fromRgb(background) : QColor(245, 245, 245));
     
     QPainter painter(&placeholder);
     painter.setPen(QColor(149, 165, 166));
@@ -1027,7 +1180,22 @@ void PropertiesPanel::setPlaceholderPreview(const QString& text)
     m_previewLabel->setPixmap(placeholder);
 }
 
+void PropertiesPanel::cancelPreviewLoading()
+{
+    if (m_previewTicket) {
+        ThumbnailLoader::instance().cancel(m_previewTicket);
+        m_previewTicket = 0;
+    }
+}
+
 void PropertiesPanel::updateProperties(const QJsonObject& properties)
+{
+    const QString backupPath = m_currentWallpaper.id.isEmpty() ? QString()
+                                                                : getBackupProjectJsonPath(m_currentWallpaper.id);
+    updateProperties(properties, !backupPath.isEmpty() && QFileInfo::exists(backupPath));
+}
+
+void PropertiesPanel::updateProperties(const QJsonObject& properties, bool hasBackup)
 {
     // Clear existing properties widget
     if (m_propertiesWidget) {
@@ -1068,12 +1236,7 @@ void PropertiesPanel::updateProperties(const QJsonObject& properties)
         m_savePropertiesButton->setEnabled(false);
         
         // Update reset button based on backup availability
-        if (!m_currentWallpaper.id.isEmpty()) {
-            QString backupPath = getBackupProjectJsonPath(m_currentWallpaper.id);
-            m_resetPropertiesButton->setEnabled(QFileInfo::exists(backupPath));
-        } else {
-            m_resetPropertiesButton->setEnabled(false);
-        }
+        m_resetPropertiesButton->setEnabled(!m_currentWallpaper.id.isEmpty() && hasBackup);
     }
     
     // Ensure proper sizing
@@ -1507,46 +1670,25 @@ bool PropertiesPanel::saveWallpaperSettings(const QString& wallpaperId)
 
 bool PropertiesPanel::loadWallpaperSettings(const QString& wallpaperId)
 {
-    QString settingsPath = getSettingsFilePath(wallpaperId);
-    
+    return applyWallpaperSettings(readSettingsDocument(getSettingsFilePath(wallpaperId)));
+}
+
+QJsonDocument PropertiesPanel::readSettingsDocument(const QString& settingsPath)
+{
+    // Thread-safe, the selection pipeline calls it from its worker
     QFile file(settingsPath);
     if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
-        // Use global defaults from ConfigManager
-        ConfigManager& config = ConfigManager::instance();
-        m_currentSettings.useGlobalDefaults = true;  // No settings file means use global defaults
-        m_currentSettings.silent = config.globalSilent();
-        m_currentSettings.volume = config.globalVolume();
-        m_currentSettings.noAutoMute = config.globalNoAutoMute();
-        m_currentSettings.noAudioProcessing = config.globalNoAudioProcessing();
-        m_currentSettings.fps = config.globalFps();
-        m_currentSettings.windowGeometry = config.globalWindowGeometry();
-        m_currentSettings.screenRoot = config.globalScreenRoot();
-        m_currentSettings.customScreenRoot = "";  // Custom screen root is per-wallpaper only
-        m_currentSettings.backgroundId = config.globalBackgroundId();
-        m_currentSettings.scaling = config.globalScaling();
-        m_currentSettings.clamping = config.globalClamping();
-        m_currentSettings.disableMouse = config.globalDisableMouse();
-        m_currentSettings.disableParallax = config.globalDisableParallax();
-        m_currentSettings.noFullscreenPause = config.globalNoFullscreenPause();
-        m_currentSettings.noLoop = config.globalNoLoop();
-        m_currentSettings.noHardwareDecode = config.globalNoHardwareDecode();
-        m_currentSettings.forceX11 = config.globalForceX11();
-        m_currentSettings.forceWayland = config.globalForceWayland();
-        m_currentSettings.verbose = config.globalVerbose();
-        m_currentSettings.logLevel = config.globalLogLevel();
-        m_currentSettings.mpvOptions = config.globalMpvOptions();
-        
-        updateSettingsControls();
-        return false;
+        return QJsonDocument();
     }
-    
-    QByteArray data = file.readAll();
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    
+    return QJsonDocument::fromJson(file.readAll());
+}
+
+bool PropertiesPanel::applyWallpaperSettings(const QJsonDocument& doc)
+{
     if (!doc.isObject()) {
-        // Use global defaults from ConfigManager on parse error
+        // No settings file, or a parse error: use global defaults from ConfigManager
         ConfigManager& config = ConfigManager::instance();
-        m_currentSettings.useGlobalDefaults = true;  // Parse error means use global defaults
+        m_currentSettings.useGlobalDefaults = true;
         m_currentSettings.silent = config.globalSilent();
         m_currentSettings.volume = config.globalVolume();
         m_currentSettings.noAutoMute = config.globalNoAutoMute();
@@ -1554,7 +1696,7 @@ bool PropertiesPanel::loadWallpaperSettings(const QString& wallpaperId)
         m_currentSettings.fps = config.globalFps();
         m_currentSettings.windowGeometry = config.globalWindowGeometry();
         m_currentSettings.screenRoot = config.globalScreenRoot();
-        m_currentSettings.customScreenRoot = "";
+        m_currentSettings.customScreenRoot = "";  // Custom screen root is per-wallpaper only
         m_currentSettings.backgroundId = config.globalBackgroundId();
         m_currentSettings.scaling = config.globalScaling();
         m_currentSettings.clamping = config.globalClamping();
@@ -1787,6 +1929,10 @@ void PropertiesPanel::clear()
 {
     qCDebug(propertiesPanel) << "Clearing properties panel";
     
+    cancelSelectionLoading();
+    cancelPreviewLoading();
+    m_scrollArea->setEnabled(true);
+    m_settingsWidget->setEnabled(true);
     m_currentWallpaper = WallpaperInfo();
     
     // Reset settings to global defaults instead of hardcoded defaults
@@ -2061,6 +2207,14 @@ QJsonObject PropertiesPanel::loadPropertiesFromProjectJson(const QString& wallpa
         return QJsonObject();
     }
     
+    QJsonObject properties = readProjectProperties(projectPath);
+    qCDebug(propertiesPanel) << "Loaded" << properties.size() << "properties from project.json for wallpaper:" << wallpaperId;
+    return properties;
+}
+
+QJsonObject PropertiesPanel::readProjectProperties(const QString& projectPath)
+{
+    // Thread-safe, the selection pipeline calls it from its worker
     // Read the project.json file
     QFile file(projectPath);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -2105,7 +2259,6 @@ QJsonObject PropertiesPanel::loadPropertiesFromProjectJson(const QString& wallpa
         }
     }
     
-    qCDebug(propertiesPanel) << "Loaded" << properties.size() << "properties from project.json for wallpaper:" << wallpaperId;
     return properties;
 }
 
@@ -2361,47 +2514,27 @@ QString PropertiesPanel::getBackupProjectJsonPath(const QString& wallpaperId) co
     return projectPath + ".backup";
 }
 
-void PropertiesPanel::loadAnimatedPreview(const QString& previewPath)
+void PropertiesPanel::loadAnimatedPreview(const QString& wallpaperId, const QString& previewPath)
 {
-    // Clean up existing movie if any
+    // Clean up existing animation if any
     stopPreviewAnimation();
     
-    // Create and configure QMovie for animation
-    m_previewMovie = new QMovie(previewPath, QByteArray(), this);
-    
-    if (!m_previewMovie->isValid()) {
-        qCWarning(propertiesPanel) << "Invalid animated preview file:" << previewPath;
-        m_previewMovie->deleteLater();
-        m_previewMovie = nullptr;
-        setPlaceholderPreview("Invalid animated preview");
-        return;
+    QSize labelSize = m_previewLabel->size();
+    if (labelSize.width() < 50 || labelSize.height() < 50) {
+        labelSize = QSize(256, 144); // Use default size if label isn't sized yet
     }
     
-    // Connect to movie signals for frame updates
-    connect(m_previewMovie, &QMovie::frameChanged, this, [this](int frameNumber) {
-        Q_UNUSED(frameNumber)
-        if (m_previewMovie) {
-            QPixmap currentFrame = m_previewMovie->currentPixmap();
-            if (!currentFrame.isNull()) {
-                // Scale the frame to fit the preview label
-                QSize labelSize = m_previewLabel->size();
-                if (labelSize.width() < 50 || labelSize.height() < 50) {
-                    labelSize = QSize(256, 144); // Use default size if label isn't sized yet
-                }
-                
-                QPixmap scaledFrame = scalePixmapKeepAspectRatio(currentFrame, labelSize);
-                m_previewLabel->setPixmap(scaledFrame);
-                       }
+    // Frames arrive pre-scaled to the label from the shared animator, decoded off the GUI thread
+    m_animationHandle = PreviewAnimator::instance().attach(wallpaperId, previewPath, labelSize, this,
+                                                           [this, previewPath, labelSize](const QPixmap& frame) {
+        if (frame.isNull()) {
+            qCWarning(propertiesPanel) << "Invalid animated preview file:" << previewPath;
+            stopPreviewAnimation();
+            setPlaceholderPreview("Invalid animated preview");
+            return;
         }
+        m_previewLabel->setPixmap(scalePixmapKeepAspectRatio(frame, labelSize));
     });
-    
-    connect(m_previewMovie, &QMovie::error, this, [this, previewPath](QImageReader::ImageReaderError error) {
-        qCWarning(propertiesPanel) << "Movie error:" << error << "for file:" << previewPath;
-        setPlaceholderPreview("Animation error");
-    });
-    
-    // Set the movie to the label and start playing
-    m_previewLabel->setMovie(m_previewMovie);
     startPreviewAnimation();
     
     qCDebug(propertiesPanel) << "Loaded animated preview for:" << previewPath;
@@ -2420,21 +2553,17 @@ bool PropertiesPanel::hasAnimatedPreview(const QString& previewPath) const
 
 void PropertiesPanel::stopPreviewAnimation()
 {
-    if (m_previewMovie) {
-        m_previewMovie->stop();
-        m_previewMovie->deleteLater();
-        m_previewMovie = nullptr;
+    if (m_animationHandle) {
+        PreviewAnimator::instance().detach(m_animationHandle);
+        m_animationHandle = 0;
     }
-    
-    // Clear any movie from the label
-    m_previewLabel->setMovie(nullptr);
 }
 
 void PropertiesPanel::startPreviewAnimation()
 {
-    if (m_previewMovie && m_previewMovie->isValid()) {
+    if (m_animationHandle) {
         qCDebug(propertiesPanel) << "Starting preview animation";
-        m_previewMovie->start();
+        PreviewAnimator::instance().setPlaying(m_animationHandle, true);
     }
 }
 
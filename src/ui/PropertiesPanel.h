@@ -18,6 +18,10 @@
 #include <QTabBar>
 #include <QMessageBox>
 #include <QEvent>
+#include <QJsonDocument>
+#include <QThreadPool>
+#include <QSharedPointer>
+#include <QAtomicInt>
 
 // These were missing or in wrong order - add them before the WallpaperSettings struct
 #include <QCheckBox>
@@ -28,7 +32,6 @@
 #include <QComboBox>
 #include <QGroupBox>
 #include <QProcess>
-#include <QMovie>
 
 #include "../core/WallpaperManager.h"
 #include "../steam/SteamApiManager.h" // Add this include for WorkshopItemInfo type
@@ -82,6 +85,7 @@ class PropertiesPanel : public QWidget
 
 public:
     explicit PropertiesPanel(QWidget* parent = nullptr);
+    ~PropertiesPanel() override;
     
     void setWallpaper(const WallpaperInfo& wallpaper);
     void setWallpaperManager(WallpaperManager* manager);
@@ -122,6 +126,10 @@ private slots:
     void onTabBarClicked(int index);
     void copyWallpaperIdToClipboard();
     void onSaveExternalNameClicked();
+    
+    // Library catalog updates for the wallpaper being shown
+    void onLibraryWallpaperUpdated(const QString& wallpaperId, WallpaperInfo::Fields changed);
+    void onLibraryWallpapersRemoved(const QStringList& wallpaperIds);
 
 protected:
     bool eventFilter(QObject *watched, QEvent *event) override;
@@ -130,13 +138,16 @@ private:
     void setupUI();
     void updatePreview(const WallpaperInfo& wallpaper);
     void updateProperties(const QJsonObject& properties);
+    void updateProperties(const QJsonObject& properties, bool hasBackup);
     void addPropertiesFromObject(QFormLayout* layout, const QJsonObject& properties, const QString& prefix);
     QWidget* createPropertyWidget(const QString& propName, const QString& type, const QJsonValue& value, const QJsonObject& propertyObj);
     QString formatFileSize(qint64 bytes);
     QPixmap scalePixmapKeepAspectRatio(const QPixmap& original, const QSize& targetSize);
-    void setPlaceholderPreview(const QString& text);
+    void setPlaceholderPreview(const QString& text, QRgb background = 0);
+    void cancelPreviewLoading();
     QJsonObject saveCurrentProperties();
-        QJsonObject loadPropertiesFromProjectJson(const QString& wallpaperId);
+    QJsonObject loadPropertiesFromProjectJson(const QString& wallpaperId);
+    static QJsonObject readProjectProperties(const QString& projectPath);
     bool loadCachedProperties(const QString& wallpaperId);
     bool saveCachedProperties(const QString& wallpaperId, const QJsonObject& properties);
     bool savePropertiesToProjectJson(const QString& wallpaperId, const QJsonObject& properties);
@@ -151,6 +162,8 @@ private:
     void updateSettingsControls();
     void updateWNELSettingsVisibility(bool isExternalWallpaper);
     bool loadWallpaperSettings(const QString& wallpaperId);
+    bool applyWallpaperSettings(const QJsonDocument& doc);
+    static QJsonDocument readSettingsDocument(const QString& settingsPath);
     bool saveWallpaperSettings(const QString& wallpaperId);
     QString getSettingsFilePath(const QString& wallpaperId);
     QStringList getAvailableScreens() const;
@@ -180,7 +193,7 @@ private:
     QScrollArea* m_scrollArea;
     
     // New UI components for settings
-    QWidget* m_settingsWidget;
+    QWidget* m_settingsWidget;  // Contents of the engine settings tab, Save Settings included
     QPushButton* m_saveSettingsButton;
     
     // Control checkbox for using global defaults
@@ -230,7 +243,23 @@ private:
     WallpaperManager* m_wallpaperManager;
     
     // Animation support for preview
-    QMovie* m_previewMovie;
+    quint64 m_animationHandle;  // PreviewAnimator handle, 0 if none
+    quint64 m_previewTicket;    // Pending ThumbnailLoader request, 0 if none
+    
+    // Selection pipeline: what setWallpaper() reads from disk, loaded off the GUI thread.
+    // A newer selection raises the flag of the older one, so fast clicking through the
+    // grid drops stale loads instead of applying them one after another.
+    struct SelectionData {
+        QJsonObject properties;   // From project.json, empty if it could not be read
+        QJsonDocument settings;   // Per-wallpaper settings file, null if missing or invalid
+        bool hasBackup = false;   // project.json.backup exists
+    };
+    void loadSelectionAsync(const WallpaperInfo& wallpaper);
+    void applySelectionData(const WallpaperInfo& wallpaper, const SelectionData& data);
+    void cancelSelectionLoading();
+    
+    QThreadPool m_selectionPool;
+    QSharedPointer<QAtomicInt> m_selectionCancelled;  // Flag of the load in flight, null if none
     
     // Track modified properties
     QMap<QString, QWidget*> m_propertyWidgets;
@@ -271,7 +300,7 @@ private:
     // Animation helper methods for preview
     void startPreviewAnimation();
     void stopPreviewAnimation();
-    void loadAnimatedPreview(const QString& previewPath);
+    void loadAnimatedPreview(const QString& wallpaperId, const QString& previewPath);
     bool hasAnimatedPreview(const QString& previewPath) const;
 
     // Tab widget is now public to fix segmentation fault issues
@@ -408,6 +408,29 @@ QWidget* SettingsDialog::createThemeTab()
             });
     
     layout->addWidget(themeGroup);
+    
+    // Wallpaper grid layout
+    auto *gridGroup = new QGroupBox("Wallpaper Grid");
+    auto *gridLayout = new QVBoxLayout(gridGroup);
+    m_virtualizedGridCheckBox = new QCheckBox("Show the whole library in one scrolling grid");
+    m_virtualizedGridCheckBox->setToolTip("Only the tiles on screen are drawn, so large libraries scroll "
+                                          "without pages. Animated previews are shown as still images.");
+    gridLayout->addWidget(m_virtualizedGridCheckBox);
+    
+    auto *animationsLayout = new QHBoxLayout;
+    animationsLayout->addWidget(new QLabel("Animated previews playing at once:"));
+    m_maxAnimationsSpinBox = new QSpinBox;
+    m_maxAnimationsSpinBox->setRange(1, 64);
+    m_maxAnimationsSpinBox->setToolTip("Only previews that are on screen play; beyond this many, "
+                                       "the rest wait as still images until one scrolls away.");
+    animationsLayout->addWidget(m_maxAnimationsSpinBox);
+    animationsLayout->addStretch();
+    gridLayout->addLayout(animationsLayout);
+    m_transcodeAnimationsCheckBox = new QCheckBox("Keep small copies of animated previews");
+    m_transcodeAnimationsCheckBox->setToolTip("Animated previews are converted once to tile size and "
+                                              "cached on disk, so large GIFs are not decoded again.");
+    gridLayout->addWidget(m_transcodeAnimationsCheckBox);
+    layout->addWidget(gridGroup);
     layout->addStretch();
     
     // Set the scroll widget
@@ -978,6 +1001,10 @@ void SettingsDialog::loadSettings()
         }
     }
     
+    m_virtualizedGridCheckBox->setChecked(m_config.virtualizedGridEnabled());
+    m_maxAnimationsSpinBox->setValue(m_config.maxPreviewAnimations());
+    m_transcodeAnimationsCheckBox->setChecked(m_config.transcodeAnimatedPreviews());
+    
     // Load WNEL settings
     m_enableWNELCheckbox->setChecked(m_config.isWNELAddonEnabled());
     m_externalWallpapersPathEdit->setText(m_config.externalWallpapersPath());
@@ -1059,6 +1086,9 @@ void SettingsDialog::saveSettings()
     } else {
         m_config.setTheme(selectedTheme);
     }
+    m_config.setVirtualizedGridEnabled(m_virtualizedGridCheckBox->isChecked());
+    m_config.setMaxPreviewAnimations(m_maxAnimationsSpinBox->value());
+    m_config.setTranscodeAnimatedPreviews(m_transcodeAnimationsCheckBox->isChecked());
     
     // Save WNEL settings
     m_config.setWNELAddonEnabled(m_enableWNELCheckbox->isChecked());
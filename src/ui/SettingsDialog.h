@@ -101,6 +101,9 @@ private:
     // Theme tab components
     QComboBox* m_themeComboBox;
     QLabel* m_themePreviewLabel;
+    QCheckBox* m_virtualizedGridCheckBox;
+    QSpinBox* m_maxAnimationsSpinBox;
+    QCheckBox* m_transcodeAnimationsCheckBox;
     
     // Extra tab components
     QCheckBox* m_enableWNELCheckbox;
@@ -1,5 +1,7 @@
 #include "PlaylistPreview.h"
 #include "../addons/WNELAddon.h"  // Add WNELAddon include
+#include "../thumbnails/ThumbnailLoader.h"
+#include "../thumbnails/PreviewAnimator.h"
 #include <QApplication>
 #include <QStyle>
 #include <QPixmap>
@@ -12,6 +14,7 @@
 #include <QDebug>
 #include <QFileInfo>
 #include <QLoggingCategory>
+#include <QScrollBar>
 
 Q_LOGGING_CATEGORY(playlistPreview, "app.playlistpreview")
 
@@ -24,6 +27,8 @@ PlaylistPreview::PlaylistPreview(WallpaperPlaylist* playlist, WallpaperManager*
     , m_currentItemsPerRow(PREFERRED_ITEMS_PER_ROW)
     , m_lastContainerWidth(0)
     , m_layoutUpdatePending(false)
+    , m_animationTimer(new QTimer(this))
+    , m_animationsSuspended(false)
     , m_dragStartPosition(-1)
     , m_isDragging(false)
 {
@@ -33,6 +38,9 @@ PlaylistPreview::PlaylistPreview(WallpaperPlaylist* playlist, WallpaperManager*
     
     setupUI();
     
+    m_animationTimer->setSingleShot(true);
+    connect(m_animationTimer, &QTimer::timeout, this, &PlaylistPreview::updateVisibleAnimations);
+    
     // Connect playlist signals
     if (m_playlist) {
         connect(m_playlist, &WallpaperPlaylist::wallpaperAdded, this, &PlaylistPreview::onWallpaperAdded);
@@ -48,7 +56,9 @@ PlaylistPreview::PlaylistPreview(WallpaperPlaylist* playlist, WallpaperManager*
     // Connect wallpaper manager signals
     if (m_wallpaperManager) {
         connect(m_wallpaperManager, &WallpaperManager::refreshFinished, this, &PlaylistPreview::onWallpaperManagerRefreshFinished);
-        qCDebug(playlistPreview) << "PlaylistPreview::PlaylistPreview() - Connected to WallpaperManager refreshFinished signal";
+        connect(m_wallpaperManager, &WallpaperManager::wallpapersAdded, this, &PlaylistPreview::onLibraryWallpapersAdded);
+        connect(m_wallpaperManager, &WallpaperManager::wallpaperUpdated, this, &PlaylistPreview::onLibraryWallpaperUpdated);
+        qCDebug(playlistPreview) << "PlaylistPreview::PlaylistPreview() - Connected to WallpaperManager refresh and catalog signals";
     }
     
     // Enable drag and drop
@@ -85,6 +95,10 @@ void PlaylistPreview::setupUI()
     
     m_scrollArea->setWidget(m_scrollContent);
     m_mainLayout->addWidget(m_scrollArea, 1); // Give it most of the space
+    
+    // Tiles scrolled out of the viewport stop animating
+    connect(m_scrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, [this]() { scheduleAnimationUpdate(); });
 }
 
 void PlaylistPreview::setupPlaylistControls()
@@ -204,6 +218,9 @@ void PlaylistPreview::updatePlaylistItems()
         m_gridLayout->addWidget(emptyLabel, 0, 0, 1, itemsPerRow);
     }
     
+    // Let the new items get their geometry before deciding which ones are on screen
+    scheduleAnimationUpdate(ANIMATION_START_DELAY_MS);
+    
     qCDebug(playlistPreview) << "PlaylistPreview::updatePlaylistItems() - END";
 }
 
@@ -425,11 +442,60 @@ void PlaylistPreview::onWallpaperManagerRefreshFinished()
 {
     qCDebug(playlistPreview) << "PlaylistPreview::onWallpaperManagerRefreshFinished() - WallpaperManager refresh completed, updating playlist items";
     
-    // Now that wallpapers are loaded, refresh the playlist items to get proper names and previews
-    updatePlaylistItems();
+    // Now that wallpapers are loaded, patch the existing items with proper names and previews;
+    // only rebuild when the widgets no longer line up with the playlist
+    if (!m_playlist || m_itemWidgets.size() != m_playlist->getPlaylistItems().size()) {
+        updatePlaylistItems();
+    } else {
+        syncItemsWithLibrary();
+    }
     updatePlaybackControls();
 }
 
+void PlaylistPreview::onLibraryWallpapersAdded(const QStringList& wallpaperIds)
+{
+    // Items for wallpapers that were missing from the library still show fallback info
+    syncItemsWithLibrary(wallpaperIds);
+}
+
+void PlaylistPreview::onLibraryWallpaperUpdated(const QString& wallpaperId, WallpaperInfo::Fields changed)
+{
+    Q_UNUSED(changed)
+    syncItemsWithLibrary(QStringList{wallpaperId});
+}
+
+void PlaylistPreview::syncItemsWithLibrary(const QStringList& wallpaperIds)
+{
+    int patched = 0;
+    for (PlaylistPreviewItem* widget : m_itemWidgets) {
+        if (!widget) {
+            continue;
+        }
+        
+        const QString& wallpaperId = widget->playlistItem().wallpaperId;
+        if (!wallpaperIds.isEmpty() && !wallpaperIds.contains(wallpaperId)) {
+            continue;
+        }
+        
+        auto wallpaperInfo = getWallpaperInfo(wallpaperId);
+        if (!wallpaperInfo.has_value()) {
+            continue;
+        }
+        
+        WallpaperInfo::Fields changed = widget->getWallpaperInfo().changedFields(wallpaperInfo.value());
+        if (changed) {
+            widget->setWallpaperInfo(wallpaperInfo.value(), changed);
+            patched++;
+        }
+    }
+    
+    qCDebug(playlistPreview) << "PlaylistPreview::syncItemsWithLibrary() - Patched" << patched << "items";
+    
+    if (patched > 0) {
+        scheduleAnimationUpdate();  // A preview may have become animated
+    }
+}
+
 // Drag and drop implementation
 void PlaylistPreview::dragEnterEvent(QDragEnterEvent* event)
 {
@@ -499,6 +565,24 @@ void PlaylistPreview::resizeEvent(QResizeEvent* event)
             layoutTimer->start(50);
         }
     }
+    
+    scheduleAnimationUpdate();
+}
+
+void PlaylistPreview::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    
+    // Also sent when the playlist tab becomes current again
+    scheduleAnimationUpdate();
+}
+
+void PlaylistPreview::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+    
+    m_animationTimer->stop();
+    stopItemAnimations();
 }
 
 int PlaylistPreview::calculateItemsPerRow() const
@@ -591,7 +675,9 @@ PlaylistPreviewItem::PlaylistPreviewItem(const PlaylistItem& item, int index, Pl
     , m_isCurrent(false)
     , m_selected(false)
     , m_playlistPreview(parent)
-    , m_previewMovie(nullptr)
+    , m_thumbnailTicket(0)
+    , m_requestedRatio(0.0)
+    , m_animationHandle(0)
     , m_useCustomPainting(true)
 {
     setFixedSize(ITEM_WIDTH, ITEM_HEIGHT + 20);
@@ -679,19 +765,60 @@ void PlaylistPreviewItem::loadPreviewImage()
             return;
         }
         
-        // Load static image
-        QPixmap pixmap(m_wallpaperInfo.previewPath);
-        if (!pixmap.isNull()) {
-            qCDebug(playlistPreview) << "Successfully loaded static preview, size:" << pixmap.size();
-            setPreviewPixmap(pixmap);
-        } else {
-            qCDebug(playlistPreview) << "Failed to load pixmap from:" << m_wallpaperInfo.previewPath;
-        }
+        loadStaticPreview();
     } else {
         qCDebug(playlistPreview) << "Preview path is empty or doesn't exist:" << m_wallpaperInfo.previewPath;
     }
 }
 
+void PlaylistPreviewItem::loadStaticPreview()
+{
+    // Same pipeline and caches as the wallpaper grid, so tiles shown in both decode once
+    ThumbnailLoader& loader = ThumbnailLoader::instance();
+    loader.cancel(m_thumbnailTicket);
+    m_requestedRatio = devicePixelRatioF();
+    const QString previewPath = m_wallpaperInfo.previewPath;
+    m_thumbnailTicket = loader.request(m_wallpaperInfo.id, previewPath, QSize(PREVIEW_WIDTH, PREVIEW_HEIGHT),
+                                       devicePixelRatioF(), this, [this, previewPath](const QPixmap& pixmap) {
+        m_thumbnailTicket = 0;
+        if (pixmap.isNull()) {
+            qCDebug(playlistPreview) << "Failed to load preview from:" << previewPath;
+            return;
+        }
+        if (previewPath == m_wallpaperInfo.previewPath) {
+            setPreviewPixmap(pixmap);
+        }
+    });
+}
+
+void PlaylistPreviewItem::releaseAnimation()
+{
+    if (m_animationHandle) {
+        PreviewAnimator::instance().detach(m_animationHandle);
+        m_animationHandle = 0;
+    }
+}
+
+void PlaylistPreviewItem::setWallpaperInfo(const WallpaperInfo& wallpaperInfo, WallpaperInfo::Fields changed)
+{
+    m_wallpaperInfo = wallpaperInfo;
+    
+    if (changed & WallpaperInfo::PreviewField) {
+        bool wasPlaying = isAnimationPlaying();
+        releaseAnimation();
+        
+        m_scaledPreview = QPixmap();
+        ThumbnailLoader::instance().invalidate(m_wallpaperInfo.id, m_wallpaperInfo.previewPath);
+        loadPreviewImage();
+        
+        if (wasPlaying) {
+            startAnimation();
+        }
+    }
+    
+    update();
+}
+
 void PlaylistPreviewItem::setPreviewPixmap(const QPixmap& pixmap)
 {
     if (pixmap.isNull()) {
@@ -704,10 +831,14 @@ void PlaylistPreviewItem::setPreviewPixmap(const QPixmap& pixmap)
 
 QPixmap PlaylistPreviewItem::scalePreviewKeepAspectRatio(const QPixmap& original)
 {
-    QSize containerSize(PREVIEW_WIDTH, PREVIEW_HEIGHT);
+    // Thumbnails come in physical pixels for the screen they were requested for
+    const qreal ratio = original.devicePixelRatio();
+    QSize containerSize = ThumbnailLoader::pixelSize(QSize(PREVIEW_WIDTH, PREVIEW_HEIGHT), ratio);
     QSize scaledSize = calculateFitSize(original.size(), containerSize);
     
-    return original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QPixmap scaled = original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    scaled.setDevicePixelRatio(ratio);
+    return scaled;
 }
 
 QSize PlaylistPreviewItem::calculateFitSize(const QSize& imageSize, const QSize& containerSize)
@@ -732,69 +863,46 @@ bool PlaylistPreviewItem::hasAnimatedPreview() const
 
 void PlaylistPreviewItem::loadAnimatedPreview()
 {
-    if (!hasAnimatedPreview()) {
+    if (!hasAnimatedPreview() || m_animationHandle) {
         return;
     }
     
-    // Clean up existing movie if any
-    if (m_previewMovie) {
-        m_previewMovie->stop();
-        m_previewMovie->deleteLater();
-        m_previewMovie = nullptr;
-    }
-    
-    // Create and configure QMovie for animation
-    m_previewMovie = new QMovie(m_wallpaperInfo.previewPath, QByteArray(), this);
-    
-    if (!m_previewMovie->isValid()) {
-        m_previewMovie->deleteLater();
-        m_previewMovie = nullptr;
-        // Fall back to static image
-        QPixmap staticPixmap(m_wallpaperInfo.previewPath);
-        if (!staticPixmap.isNull()) {
-            setPreviewPixmap(staticPixmap);
+    // Shares decoded frames with the wallpaper grid, both show previews at the same size
+    const QString previewPath = m_wallpaperInfo.previewPath;
+    m_animationHandle = PreviewAnimator::instance().attach(m_wallpaperInfo.id, previewPath,
+                                                           QSize(PREVIEW_WIDTH, PREVIEW_HEIGHT), this,
+                                                           [this, previewPath](const QPixmap& frame) {
+        if (previewPath != m_wallpaperInfo.previewPath) {
+            return;
         }
-        return;
-    }
-    
-    // Connect to movie signals for frame updates
-    connect(m_previewMovie, &QMovie::frameChanged, this, [this](int frameNumber) {
-        Q_UNUSED(frameNumber)
-        if (m_previewMovie) {
-            QPixmap currentFrame = m_previewMovie->currentPixmap();
-            if (!currentFrame.isNull()) {
-                m_scaledPreview = scalePreviewKeepAspectRatio(currentFrame);
-                update();
-            }
+        if (frame.isNull()) {
+            // Fall back to static image; nothing to play, so the handle goes too
+            releaseAnimation();
+            loadStaticPreview();
+            return;
         }
-    });
-    
-    // Get the first frame
-    m_previewMovie->jumpToFrame(0);
-    QPixmap firstFrame = m_previewMovie->currentPixmap();
-    if (!firstFrame.isNull()) {
-        m_scaledPreview = scalePreviewKeepAspectRatio(firstFrame);
+        m_scaledPreview = frame;
         update();
-    }
+    });
 }
 
 void PlaylistPreviewItem::startAnimation()
 {
-    if (m_previewMovie && m_previewMovie->isValid()) {
-        m_previewMovie->start();
+    if (m_animationHandle) {
+        PreviewAnimator::instance().setPlaying(m_animationHandle, true);
     }
 }
 
 void PlaylistPreviewItem::stopAnimation()
 {
-    if (m_previewMovie && m_previewMovie->state() == QMovie::Running) {
-        m_previewMovie->stop();
+    if (m_animationHandle) {
+        PreviewAnimator::instance().setPlaying(m_animationHandle, false);
     }
 }
 
 bool PlaylistPreviewItem::isAnimationPlaying() const
 {
-    return m_previewMovie && m_previewMovie->state() == QMovie::Running;
+    return m_animationHandle && PreviewAnimator::instance().isPlaying(m_animationHandle);
 }
 
 void PlaylistPreviewItem::setIndex(int index)
@@ -857,12 +965,19 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
     
     // Draw preview image
     if (!m_scaledPreview.isNull()) {
+        // Moved to a screen with another scale factor: swap in the thumbnail variant made for it
+        // Compared with the last request, not the pixmap, so a failed decode is not retried on every paint
+        if (!m_animationHandle && !m_thumbnailTicket && !qFuzzyCompare(m_requestedRatio, devicePixelRatioF())) {
+            QMetaObject::invokeMethod(this, &PlaylistPreviewItem::loadStaticPreview, Qt::QueuedConnection);
+        }
+        
         QRect previewRect = QRect(PREVIEW_CONTAINER_MARGIN, PREVIEW_CONTAINER_MARGIN, 
                                  previewWidth, previewHeight);
         
+        const QSize previewSize = m_scaledPreview.deviceIndependentSize().toSize();
         QRect imageRect = previewRect;
-        if (m_scaledPreview.size() != previewRect.size()) {
-            QSize scaledSize = m_scaledPreview.size().scaled(previewRect.size(), Qt::KeepAspectRatio);
+        if (previewSize != previewRect.size()) {
+            QSize scaledSize = previewSize.scaled(previewRect.size(), Qt::KeepAspectRatio);
             imageRect = QRect(
                 previewRect.x() + (previewRect.width() - scaledSize.width()) / 2,
                 previewRect.y() + (previewRect.height() - scaledSize.height()) / 2,
@@ -877,9 +992,14 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
                                  previewWidth, previewHeight);
         
         if (previewRect.width() > 0 && previewRect.height() > 0) {
-            painter.fillRect(previewRect, QColor(60, 60, 60));
-            painter.setPen(QColor(120, 120, 120));
-            painter.drawText(previewRect, Qt::AlignCenter, "Loading...");
+            // The scan's dominant colour stands in until the thumbnail is decoded
+            if (m_wallpaperInfo.placeholderColor != 0) {
+                painter.fillRect(previewRect, QColor::fromRgb(m_wallpaperInfo.placeholderColor));
+            } else {
+                painter.fillRect(previewRect, QColor(60, 60, 60));
+                painter.setPen(QColor(120, 120, 120));
+                painter.drawText(previewRect, Qt::AlignCenter, "Loading...");
+            }
         }
     }
     
@@ -904,7 +1024,7 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
         int maxNameLines = qMax(1, qMin(3, maxTextHeight / nameLineHeight - 2));
         
         QRect nameRect = QRect(textRect.x(), textRect.y(), textRect.width(), nameLineHeight * maxNameLines);
-        drawTextWithWordWrap(painter, displayName, nameRect, nameFont, palette().color(QPalette::Text));
+        drawTextWithWordWrap(painter, m_nameText, displayName, nameRect, nameFont, palette().color(QPalette::Text));
         
         QFont infoFont = font();
         infoFont.setPointSize(qMax(7, font().pointSize() - 1));
@@ -921,22 +1041,43 @@ void PlaylistPreviewItem::paintEvent(QPaintEvent* event)
             QString infoText = infoLines.join(" • ");
             if (!infoText.isEmpty()) {
                 painter.setPen(palette().color(QPalette::Mid));
-                drawTextWithWordWrap(painter, infoText, infoRect, infoFont, palette().color(QPalette::Mid));
+                drawTextWithWordWrap(painter, m_infoText, infoText, infoRect, infoFont, palette().color(QPalette::Mid));
             }
         }
     }
 }
 
-void PlaylistPreviewItem::drawTextWithWordWrap(QPainter& painter, const QString& text, const QRect& rect, 
-                                             const QFont& font, const QColor& color, Qt::Alignment alignment)
+void PlaylistPreviewItem::drawTextWithWordWrap(QPainter& painter, WrappedText& cache, const QString& text,
+                                              const QRect& rect, const QFont& font, const QColor& color,
+                                              Qt::Alignment alignment)
 {
     if (text.isEmpty() || rect.isEmpty()) {
         return;
     }
     
+    // Hover, selection and animation frames repaint the tile without changing its text
+    if (cache.text != text || cache.font != font || cache.size != rect.size() || cache.alignment != alignment) {
+        layoutWrappedText(cache, text, rect.size(), font, alignment);
+    }
+    
     painter.setFont(font);
     painter.setPen(color);
     
+    for (int i = 0; i < cache.lines.size(); ++i) {
+        painter.drawStaticText(rect.topLeft() + cache.offsets.at(i), cache.lines.at(i));
+    }
+}
+
+void PlaylistPreviewItem::layoutWrappedText(WrappedText& cache, const QString& text, const QSize& size,
+                                           const QFont& font, Qt::Alignment alignment)
+{
+    cache.text = text;
+    cache.font = font;
+    cache.size = size;
+    cache.alignment = alignment;
+    cache.lines.clear();
+    cache.offsets.clear();
+    
     QFontMetrics fm(font);
     QStringList words = text.split(' ', Qt::SkipEmptyParts);
     
@@ -950,16 +1091,16 @@ void PlaylistPreviewItem::drawTextWithWordWrap(QPainter& painter, const QString&
     for (const QString& word : words) {
         QString testLine = currentLine.isEmpty() ? word : currentLine + " " + word;
         
-        if (fm.horizontalAdvance(testLine) <= rect.width()) {
+        if (fm.horizontalAdvance(testLine) <= size.width()) {
             currentLine = testLine;
         } else {
             if (!currentLine.isEmpty()) {
                 lines.append(currentLine);
                 currentLine = word;
             } else {
-                currentLine = fm.elidedText(word, Qt::ElideRight, rect.width());
+                currentLine = fm.elidedText(word, Qt::ElideRight, size.width());
                 lines.append(currentLine);
-                currentLine = "";
+                currentLine.clear();
             }
         }
     }
@@ -969,25 +1110,33 @@ void PlaylistPreviewItem::drawTextWithWordWrap(QPainter& painter, const QString&
     }
     
     int lineHeight = fm.height();
-    int startY = rect.y();
+    int startY = 0;
     
     Qt::Alignment vAlign = alignment & Qt::AlignVertical_Mask;
     if (vAlign == Qt::AlignVCenter) {
         int usedHeight = lines.size() * lineHeight;
-        startY = rect.y() + (rect.height() - usedHeight) / 2;
+        startY = (size.height() - usedHeight) / 2;
     } else if (vAlign == Qt::AlignBottom) {
         int usedHeight = lines.size() * lineHeight;
-        startY = rect.bottom() - usedHeight;
+        startY = size.height() - 1 - usedHeight;
     }
     
+    Qt::Alignment hAlign = alignment & Qt::AlignHorizontal_Mask;
     for (int i = 0; i < lines.size(); ++i) {
-        QString line = lines[i];
-        QRect lineRect = QRect(rect.x(), startY + i * lineHeight, rect.width(), lineHeight);
+        QStaticText line(lines[i]);
+        line.setTextFormat(Qt::PlainText);
+        line.prepare(QTransform(), font);
         
-        Qt::Alignment hAlign = alignment & Qt::AlignHorizontal_Mask;
-        if (hAlign == 0) hAlign = Qt::AlignLeft;
+        int x = 0;
+        int lineWidth = fm.horizontalAdvance(lines[i]);
+        if (hAlign & Qt::AlignRight) {
+            x = size.width() - lineWidth;
+        } else if (hAlign & Qt::AlignHCenter) {
+            x = (size.width() - lineWidth) / 2;
+        }
         
-        painter.drawText(lineRect, hAlign | Qt::AlignVCenter, line);
+        cache.lines.append(line);
+        cache.offsets.append(QPoint(x, startY + i * lineHeight));
     }
 }
 
@@ -1120,9 +1269,8 @@ std::optional<WallpaperInfo> PlaylistPreview::getWallpaperInfo(const QString& wa
 {
     // First try to get from regular wallpapers
     if (m_wallpaperManager) {
-        auto wallpaperInfo = m_wallpaperManager->getWallpaperInfo(wallpaperId);
-        if (wallpaperInfo.has_value()) {
-            return wallpaperInfo;
+        if (WallpaperInfoPtr wallpaper = m_wallpaperManager->findWallpaper(wallpaperId)) {
+            return *wallpaper;
         }
     }
     
@@ -1143,35 +1291,54 @@ void PlaylistPreview::stopAllPreviewAnimations()
 {
     qCDebug(playlistPreview) << "Stopping all playlist preview animations to save CPU when minimized";
     
-    // Stop animations in all playlist preview items
-    for (int row = 0; row < m_gridLayout->rowCount(); ++row) {
-        for (int col = 0; col < m_gridLayout->columnCount(); ++col) {
-            QLayoutItem* layoutItem = m_gridLayout->itemAtPosition(row, col);
-            if (layoutItem && layoutItem->widget()) {
-                PlaylistPreviewItem* item = qobject_cast<PlaylistPreviewItem*>(layoutItem->widget());
-                if (item && item->isAnimationPlaying()) {
-                    item->stopAnimation();
-                }
-            }
-        }
-    }
+    m_animationsSuspended = true;
+    m_animationTimer->stop();
+    stopItemAnimations();
 }
 
 void PlaylistPreview::startAllPreviewAnimations()
 {
     qCDebug(playlistPreview) << "Starting playlist preview animations when window becomes active";
     
-    // Start animations in all playlist preview items that have animated previews
-    for (int row = 0; row < m_gridLayout->rowCount(); ++row) {
-        for (int col = 0; col < m_gridLayout->columnCount(); ++col) {
-            QLayoutItem* layoutItem = m_gridLayout->itemAtPosition(row, col);
-            if (layoutItem && layoutItem->widget()) {
-                PlaylistPreviewItem* item = qobject_cast<PlaylistPreviewItem*>(layoutItem->widget());
-                if (item && item->hasAnimatedPreview() && !item->isAnimationPlaying()) {
-                    // Re-trigger animation loading (this will start it automatically)
-                    item->loadAnimatedPreview();
-                }
-            }
+    m_animationsSuspended = false;
+    updateVisibleAnimations();
+}
+
+void PlaylistPreview::scheduleAnimationUpdate(int delayMs)
+{
+    if (!m_animationTimer->isActive() || m_animationTimer->remainingTime() < delayMs) {
+        m_animationTimer->start(delayMs);
+    }
+}
+
+void PlaylistPreview::updateVisibleAnimations()
+{
+    if (m_animationsSuspended || !isVisible()) {
+        stopItemAnimations();
+        return;
+    }
+    
+    // Item geometry is in m_scrollContent coordinates, which the scroll area moves under the viewport
+    const QRect visibleRect(-m_scrollContent->pos(), m_scrollArea->viewport()->size());
+    
+    for (PlaylistPreviewItem* item : m_itemWidgets) {
+        if (!item) {
+            continue;
+        }
+        if (item->geometry().intersects(visibleRect) && item->hasAnimatedPreview()) {
+            item->loadAnimatedPreview();  // No-op once attached
+            item->startAnimation();
+        } else if (item->isAnimationPlaying()) {
+            item->stopAnimation();
+        }
+    }
+}
+
+void PlaylistPreview::stopItemAnimations()
+{
+    for (PlaylistPreviewItem* item : m_itemWidgets) {
+        if (item && item->isAnimationPlaying()) {
+            item->stopAnimation();
         }
     }
 }
@@ -21,9 +21,11 @@
 #include <QMouseEvent>
 #include <QPaintEvent>
 #include <QPainter>
+#include <QStaticText>
 #include <QResizeEvent>
+#include <QShowEvent>
+#include <QHideEvent>
 #include <QTimer>
-#include <QMovie>
 #include <QNetworkAccessManager>
 #include <QRandomGenerator>
 #include "../playlist/WallpaperPlaylist.h"
@@ -56,6 +58,10 @@ public:
     static constexpr int MIN_ITEMS_PER_ROW = 1;
     static constexpr int MAX_ITEMS_PER_ROW = 8;
     static constexpr int PREFERRED_ITEMS_PER_ROW = 4;
+    
+    // Animated previews play only while their tile is inside the scroll viewport
+    static constexpr int ANIMATION_START_DELAY_MS = 200;
+    static constexpr int ANIMATION_UPDATE_DELAY_MS = 100;
 
 public slots:
     void onWallpaperAdded(const QString& wallpaperId);
@@ -67,6 +73,8 @@ public slots:
     void onPlaybackStopped();
     void onSettingsChanged();
     void onWallpaperManagerRefreshFinished();
+    void onLibraryWallpapersAdded(const QStringList& wallpaperIds);
+    void onLibraryWallpaperUpdated(const QString& wallpaperId, WallpaperInfo::Fields changed);
 
 signals:
     void wallpaperSelected(const QString& wallpaperId);
@@ -77,6 +85,8 @@ protected:
     void dragMoveEvent(QDragMoveEvent* event) override;
     void dropEvent(QDropEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 
 private slots:
     void onRemoveButtonClicked();
@@ -87,12 +97,14 @@ private slots:
     void onPlaybackControlClicked();
     void onNextButtonClicked();
     void onPreviousButtonClicked();
+    void updateVisibleAnimations();
 
 private:
     void setupUI();
     void setupPlaylistControls();
     void setupPlaylistSettings();
     void updatePlaylistItems();
+    void syncItemsWithLibrary(const QStringList& wallpaperIds = QStringList());
     void updatePlaybackControls();
     void updateSettingsUI();
 
@@ -107,6 +119,8 @@ private:
     void recalculateLayout();
     void adjustGridForNewColumnCount(int newColumnCount);
     void clearCurrentItems();
+    void scheduleAnimationUpdate(int delayMs = ANIMATION_UPDATE_DELAY_MS);
+    void stopItemAnimations();
 
     WallpaperPlaylist* m_playlist;
     WallpaperManager* m_wallpaperManager;
@@ -142,6 +156,10 @@ private:
     int m_lastContainerWidth;
     bool m_layoutUpdatePending;
     
+    // Visibility-driven preview animation
+    QTimer* m_animationTimer;
+    bool m_animationsSuspended;  // Window minimized or hidden to the tray
+    
     // Drag and drop
     int m_dragStartPosition;
     bool m_isDragging;
@@ -165,6 +183,7 @@ public:
     
     // Get wallpaper info for display
     WallpaperInfo getWallpaperInfo() const { return m_wallpaperInfo; }
+    void setWallpaperInfo(const WallpaperInfo& wallpaperInfo, WallpaperInfo::Fields changed);
     
     // Animation control for preview optimization
     bool hasAnimatedPreview() const;
@@ -204,11 +223,25 @@ private slots:
 private:
     void setupUI();
     void loadPreviewImage();
+    void loadStaticPreview();
+    void releaseAnimation();
     void setPreviewPixmap(const QPixmap& pixmap);
     QPixmap scalePreviewKeepAspectRatio(const QPixmap& original);
     QSize calculateFitSize(const QSize& imageSize, const QSize& containerSize);
-    void drawTextWithWordWrap(QPainter& painter, const QString& text, const QRect& rect, 
+    // Wrapped lines of one text block, laid out once and redrawn until the text, font or size changes
+    struct WrappedText {
+        QString text;
+        QFont font;
+        QSize size;
+        Qt::Alignment alignment;
+        QList<QStaticText> lines;
+        QList<QPoint> offsets;  // Top-left of each line, relative to the block
+    };
+    
+    void drawTextWithWordWrap(QPainter& painter, WrappedText& cache, const QString& text, const QRect& rect, 
                              const QFont& font, const QColor& color, Qt::Alignment alignment = Qt::AlignLeft);
+    static void layoutWrappedText(WrappedText& cache, const QString& text, const QSize& size,
+                                  const QFont& font, Qt::Alignment alignment);
     void updateTextLayout();
 
     PlaylistItem m_item;
@@ -220,7 +253,11 @@ private:
     
     // Preview display
     QPixmap m_scaledPreview;
-    QMovie* m_previewMovie;
+    WrappedText m_nameText;
+    WrappedText m_infoText;
+    quint64 m_thumbnailTicket;  // Pending ThumbnailLoader request, 0 if none
+    qreal m_requestedRatio;     // Device pixel ratio of the last static preview request, 0 if none
+    quint64 m_animationHandle;  // PreviewAnimator handle for animated previews, 0 if none
     bool m_useCustomPainting;
     
     // Control buttons (positioned over the preview)
@@ -1,5 +1,6 @@
 #include "ScreenSelectionWidget.h"
 #include "../core/ConfigManager.h"
+#include "../thumbnails/ThumbnailLoader.h"
 #include <QGuiApplication>
 #include <QScreen>
 #include <QPainter>
@@ -37,6 +38,7 @@ void ScreenPictogram::setWallpaper(const QString& wallpaperId, const QString& wa
     m_wallpaperId = wallpaperId;
     m_wallpaperName = wallpaperName;
     m_wallpaperPreview = preview;
+    m_scaledPreview = QPixmap();
     update();
 }
 
@@ -46,6 +48,7 @@ void ScreenPictogram::clearWallpaper()
     m_wallpaperId.clear();
     m_wallpaperName.clear();
     m_wallpaperPreview = QPixmap();
+    m_scaledPreview = QPixmap();
     update();
 }
 
@@ -94,19 +97,28 @@ void ScreenPictogram::paintEvent(QPaintEvent* event)
     }
     painter.drawRoundedRect(screenRect, 5, 5);
     
-    // Draw wallpaper preview if assigned
-    if (m_hasWallpaper && !m_wallpaperPreview.isNull()) {
+    // Draw wallpaper preview if assigned; until it is decoded only the name is shown
+    if (m_hasWallpaper) {
         QRect previewRect = screenRect.adjusted(4, 4, -4, -4);
-        QPixmap scaledPreview = m_wallpaperPreview.scaled(previewRect.size(), 
-            Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-        
-        // Crop to fit
-        int offsetX = (scaledPreview.width() - previewRect.width()) / 2;
-        int offsetY = (scaledPreview.height() - previewRect.height()) / 2;
-        QPixmap croppedPreview = scaledPreview.copy(offsetX, offsetY, 
-            previewRect.width(), previewRect.height());
+        // Scaled in physical pixels so the preview stays sharp on HiDPI screens
+        const qreal ratio = devicePixelRatioF();
+        const QSize pixelSize = ThumbnailLoader::pixelSize(previewRect.size(), ratio);
+        if (!m_wallpaperPreview.isNull()
+            && (m_scaledPreview.size() != pixelSize || !qFuzzyCompare(m_scaledPreview.devicePixelRatio(), ratio))) {
+            QPixmap scaledPreview = m_wallpaperPreview.scaled(pixelSize, 
+                Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+            
+            // Crop to fit
+            int offsetX = (scaledPreview.width() - pixelSize.width()) / 2;
+            int offsetY = (scaledPreview.height() - pixelSize.height()) / 2;
+            m_scaledPreview = scaledPreview.copy(offsetX, offsetY, 
+                pixelSize.width(), pixelSize.height());
+            m_scaledPreview.setDevicePixelRatio(ratio);
+        }
         
-        painter.drawPixmap(previewRect, croppedPreview);
+        if (!m_scaledPreview.isNull()) {
+            painter.drawPixmap(previewRect, m_scaledPreview);
+        }
         
         // Draw wallpaper name overlay
         QRect nameRect = screenRect.adjusted(0, screenRect.height() - 25, 0, 0);
@@ -172,6 +184,8 @@ ScreenSelectionWidget::ScreenSelectionWidget(QWidget* parent)
 
 void ScreenSelectionWidget::updateScreens()
 {
+    cancelPreviewLoading();
+    
     // Clear existing pictograms
     for (auto* pictogram : m_screenPictograms) {
         m_layout->removeWidget(pictogram);
@@ -232,27 +246,59 @@ void ScreenSelectionWidget::updateScreens()
 }
 
 void ScreenSelectionWidget::setScreenWallpaper(const QString& technicalName, const QString& wallpaperId,
-                                               const QString& wallpaperName, const QPixmap& preview)
+                                               const QString& wallpaperName, const QString& previewPath)
 {
-    if (m_screenPictograms.contains(technicalName)) {
-        m_screenPictograms[technicalName]->setWallpaper(wallpaperId, wallpaperName, preview);
+    ScreenPictogram* pictogram = m_screenPictograms.value(technicalName);
+    if (!pictogram) {
+        return;
+    }
+    cancelPreviewLoading(technicalName);
+    
+    // The assignment counts straight away; the preview follows once decoded
+    pictogram->setWallpaper(wallpaperId, wallpaperName, QPixmap());
+    
+    // Usually already decoded for the grid, in which case the callback runs right here
+    const ThumbnailLoader::Ticket ticket = ThumbnailLoader::instance().request(
+        wallpaperId, previewPath, ThumbnailLoader::tileSize(), devicePixelRatioF(), pictogram,
+        [this, technicalName, pictogram, wallpaperId, wallpaperName](const QPixmap& preview) {
+            m_previewTickets.remove(technicalName);
+            if (pictogram->getWallpaperId() == wallpaperId) {
+                pictogram->setWallpaper(wallpaperId, wallpaperName, preview);
+            }
+        });
+    if (ticket != 0) {
+        m_previewTickets.insert(technicalName, ticket);
     }
 }
 
 void ScreenSelectionWidget::clearScreenWallpaper(const QString& technicalName)
 {
     if (m_screenPictograms.contains(technicalName)) {
+        cancelPreviewLoading(technicalName);
         m_screenPictograms[technicalName]->clearWallpaper();
     }
 }
 
 void ScreenSelectionWidget::clearAllScreenWallpapers()
 {
+    cancelPreviewLoading();
     for (auto* pictogram : m_screenPictograms) {
         pictogram->clearWallpaper();
     }
 }
 
+void ScreenSelectionWidget::cancelPreviewLoading(const QString& technicalName)
+{
+    if (!technicalName.isEmpty()) {
+        ThumbnailLoader::instance().cancel(m_previewTickets.take(technicalName));
+        return;
+    }
+    for (ThumbnailLoader::Ticket ticket : std::as_const(m_previewTickets)) {
+        ThumbnailLoader::instance().cancel(ticket);
+    }
+    m_previewTickets.clear();
+}
+
 QString ScreenSelectionWidget::getSelectedScreen() const
 {
     return m_selectedScreen;
@@ -10,6 +10,7 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QPixmap>
+#include "../thumbnails/ThumbnailLoader.h"
 
 // Widget for displaying a single screen pictogram
 class ScreenPictogram : public QWidget
@@ -45,6 +46,7 @@ private:
     QString m_wallpaperId;
     QString m_wallpaperName;
     QPixmap m_wallpaperPreview;
+    QPixmap m_scaledPreview;  // m_wallpaperPreview cropped to the preview rect, rebuilt on resize
 };
 
 // Main screen selection widget
@@ -56,8 +58,10 @@ public:
     explicit ScreenSelectionWidget(QWidget* parent = nullptr);
     
     void updateScreens();
+    // The preview comes from the shared thumbnail cache at tile size, not the full-size file,
+    // and is decoded in the background on a miss
     void setScreenWallpaper(const QString& technicalName, const QString& wallpaperId, 
-                           const QString& wallpaperName, const QPixmap& preview);
+                           const QString& wallpaperName, const QString& previewPath);
     void clearScreenWallpaper(const QString& technicalName);
     void clearAllScreenWallpapers();
     QString getSelectedScreen() const;
@@ -72,8 +76,12 @@ private slots:
     void onScreenClicked(const QString& technicalName);
 
 private:
+    // Cancels the preview decode for one screen, or for all of them if technicalName is empty
+    void cancelPreviewLoading(const QString& technicalName = QString());
+
     QHBoxLayout* m_layout;
     QMap<QString, ScreenPictogram*> m_screenPictograms;  // Technical name -> pictogram
+    QMap<QString, ThumbnailLoader::Ticket> m_previewTickets;  // Technical name -> pending preview decode
     QString m_selectedScreen;
 };
 
@@ -0,0 +1,317 @@
+#include "WallpaperGridView.h"
+#include "WallpaperPreview.h"
+#include "../thumbnails/ThumbnailLoader.h"
+#include "../thumbnails/ThumbnailCache.h"
+#include <QPainter>
+#include <QPixmap>
+#include <QMimeData>
+#include <QFontMetrics>
+
+WallpaperGridModel::WallpaperGridModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_devicePixelRatio(1.0)
+{
+}
+
+WallpaperGridModel::~WallpaperGridModel()
+{
+    cancelThumbnails();
+}
+
+void WallpaperGridModel::setWallpapers(const QList<WallpaperInfoPtr>& wallpapers)
+{
+    beginResetModel();
+    cancelThumbnails();
+    m_wallpapers = wallpapers;
+    m_rows.clear();
+    m_rows.reserve(m_wallpapers.size());
+    for (int row = 0; row < m_wallpapers.size(); ++row) {
+        m_rows.insert(m_wallpapers[row]->id, row);
+    }
+    endResetModel();
+}
+
+void WallpaperGridModel::updateWallpaper(const WallpaperInfoPtr& wallpaper, WallpaperInfo::Fields changed)
+{
+    const int row = rowOf(wallpaper->id);
+    if (row < 0) {
+        return;
+    }
+    m_wallpapers[row] = wallpaper;
+
+    if (changed & WallpaperInfo::PreviewField) {
+        // Drop thumbnails of the old file, so the next paint decodes the new one
+        ThumbnailLoader::instance().invalidate(wallpaper->id, wallpaper->previewPath);
+        auto it = m_pendingThumbnails.find(wallpaper->id);
+        if (it != m_pendingThumbnails.end()) {
+            ThumbnailLoader::instance().cancel(it.value());
+            m_pendingThumbnails.erase(it);
+        }
+        m_failedThumbnails.remove(wallpaper->id);
+    }
+
+    const QModelIndex changedIndex = index(row);
+    emit dataChanged(changedIndex, changedIndex);
+}
+
+WallpaperInfoPtr WallpaperGridModel::wallpaperAt(int row) const
+{
+    if (row < 0 || row >= m_wallpapers.size()) {
+        return WallpaperInfoPtr();
+    }
+    return m_wallpapers.at(row);
+}
+
+int WallpaperGridModel::rowOf(const QString& wallpaperId) const
+{
+    return m_rows.value(wallpaperId, -1);
+}
+
+void WallpaperGridModel::retainThumbnails(int firstRow, int lastRow)
+{
+    ThumbnailLoader& loader = ThumbnailLoader::instance();
+    for (auto it = m_pendingThumbnails.begin(); it != m_pendingThumbnails.end();) {
+        const int row = rowOf(it.key());
+        if (row < firstRow || row > lastRow) {
+            loader.cancel(it.value());
+            it = m_pendingThumbnails.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void WallpaperGridModel::setDevicePixelRatio(qreal ratio)
+{
+    if (qFuzzyCompare(ratio, m_devicePixelRatio)) {
+        return;
+    }
+    m_devicePixelRatio = ratio;
+
+    // Rows repaint and ask for the variant of the new screen; the old one stays cached for moving back
+    cancelThumbnails();
+    m_failedThumbnails.clear();
+    if (!m_wallpapers.isEmpty()) {
+        emit dataChanged(index(0), index(m_wallpapers.size() - 1), {Qt::DecorationRole});
+    }
+}
+
+int WallpaperGridModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_wallpapers.size();
+}
+
+QVariant WallpaperGridModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_wallpapers.size()) {
+        return QVariant();
+    }
+    const WallpaperInfoPtr& wallpaper = m_wallpapers.at(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return wallpaper->name.isEmpty() ? QStringLiteral("Unknown") : wallpaper->name;
+    case Qt::ToolTipRole:
+        return wallpaper->name;
+    case Qt::DecorationRole: {
+        if (wallpaper->previewPath.isEmpty() || m_pendingThumbnails.contains(wallpaper->id)
+            || m_failedThumbnails.contains(wallpaper->id)) {
+            return QVariant();
+        }
+        const QPixmap pixmap = ThumbnailCache::instance().find(wallpaper->id, ThumbnailLoader::tileSize(),
+                                                               m_devicePixelRatio, wallpaper->previewPath);
+        if (!pixmap.isNull()) {
+            return pixmap;
+        }
+        // Only rows the view actually paints get here, which is what keeps the grid virtual
+        requestThumbnail(wallpaper);
+        return QVariant();
+    }
+    case IdRole:
+        return wallpaper->id;
+    case AuthorRole:
+        return wallpaper->author;
+    case TypeRole:
+        return wallpaper->type;
+    case PlaceholderColorRole:
+        return wallpaper->placeholderColor;
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags WallpaperGridModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+}
+
+QStringList WallpaperGridModel::mimeTypes() const
+{
+    return {QStringLiteral("text/plain"), QStringLiteral("application/x-wallpaper-id")};
+}
+
+QMimeData* WallpaperGridModel::mimeData(const QModelIndexList& indexes) const
+{
+    // Same payload as dragging a WallpaperPreviewItem, so playlist drops work unchanged
+    for (const QModelIndex& index : indexes) {
+        const WallpaperInfoPtr wallpaper = wallpaperAt(index.row());
+        if (wallpaper) {
+            QMimeData* mimeData = new QMimeData;
+            mimeData->setText(wallpaper->id);
+            mimeData->setData("application/x-wallpaper-id", wallpaper->id.toUtf8());
+            return mimeData;
+        }
+    }
+    return nullptr;
+}
+
+void WallpaperGridModel::requestThumbnail(const WallpaperInfoPtr& wallpaper) const
+{
+    const QString id = wallpaper->id;
+    auto* model = const_cast<WallpaperGridModel*>(this);
+    const quint64 ticket = ThumbnailLoader::instance().request(id, wallpaper->previewPath,
+                                                               ThumbnailLoader::tileSize(), m_devicePixelRatio,
+                                                               model,
+                                                               [model, id](const QPixmap& pixmap) {
+        if (model->m_pendingThumbnails.remove(id) == 0) {
+            return;  // Answered from the memory cache while data() was still running
+        }
+        if (pixmap.isNull()) {
+            model->m_failedThumbnails.insert(id);
+        }
+        const int row = model->rowOf(id);
+        if (row >= 0) {
+            const QModelIndex changedIndex = model->index(row);
+            emit model->dataChanged(changedIndex, changedIndex, {Qt::DecorationRole});
+        }
+    });
+    if (ticket != 0) {
+        m_pendingThumbnails.insert(id, ticket);
+    }
+}
+
+void WallpaperGridModel::cancelThumbnails()
+{
+    ThumbnailLoader& loader = ThumbnailLoader::instance();
+    for (quint64 ticket : std::as_const(m_pendingThumbnails)) {
+        loader.cancel(ticket);
+    }
+    m_pendingThumbnails.clear();
+}
+
+WallpaperGridDelegate::WallpaperGridDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+void WallpaperGridDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option,
+                                  const QModelIndex& index) const
+{
+    const int margin = WallpaperPreviewItem::PREVIEW_CONTAINER_MARGIN;
+    const int textMargin = WallpaperPreviewItem::TEXT_MARGIN;
+    const QRect tile = option.rect;
+    const bool selected = option.state.testFlag(QStyle::State_Selected);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::TextAntialiasing);
+
+    painter->fillRect(tile, option.palette.color(selected ? QPalette::Highlight : QPalette::Base));
+    if (selected) {
+        painter->setPen(QPen(option.palette.color(QPalette::Highlight), 2));
+        painter->drawRect(tile.adjusted(1, 1, -1, -1));
+    }
+
+    const int availableWidth = tile.width() - 2 * margin;
+    const int availableHeight = tile.height() - 2 * margin;
+    const QRect previewRect(tile.x() + margin, tile.y() + margin,
+                            qMin(int(WallpaperPreviewItem::PREVIEW_WIDTH), availableWidth),
+                            qMin(int(WallpaperPreviewItem::PREVIEW_HEIGHT),
+                                 availableHeight - WallpaperPreviewItem::TEXT_AREA_HEIGHT));
+
+    const QPixmap preview = qvariant_cast<QPixmap>(index.data(Qt::DecorationRole));
+    if (!preview.isNull()) {
+        const QSize scaledSize = preview.deviceIndependentSize().toSize().scaled(previewRect.size(),
+                                                                                 Qt::KeepAspectRatio);
+        const QRect imageRect(previewRect.x() + (previewRect.width() - scaledSize.width()) / 2,
+                              previewRect.y() + (previewRect.height() - scaledSize.height()) / 2,
+                              scaledSize.width(), scaledSize.height());
+        painter->drawPixmap(imageRect, preview);
+    } else if (previewRect.width() > 0 && previewRect.height() > 0) {
+        const QRgb placeholder = index.data(WallpaperGridModel::PlaceholderColorRole).toUInt();
+        if (placeholder != 0) {
+            painter->fillRect(previewRect, QColor::fromRgb(placeholder));
+        } else {
+            painter->fillRect(previewRect, QColor(60, 60, 60));
+            painter->setPen(QColor(120, 120, 120));
+            painter->drawText(previewRect, Qt::AlignCenter, "Loading...");
+        }
+    }
+
+    const int textY = previewRect.bottom() + 1 + textMargin;
+    const QRect textRect(tile.x() + margin + textMargin / 2, textY, availableWidth - textMargin,
+                         tile.bottom() - textY - textMargin);
+    if (textRect.width() > 0 && textRect.height() > 0) {
+        QFont nameFont = option.font;
+        nameFont.setBold(true);
+        nameFont.setPointSize(qMax(8, option.font.pointSize()));
+        const QFontMetrics nameFm(nameFont);
+
+        // Two wrapped lines at most, the second one elided
+        const QString name = index.data(Qt::DisplayRole).toString();
+        const QRect nameRect(textRect.x(), textRect.y(), textRect.width(), nameFm.height() * 2);
+        painter->setFont(nameFont);
+        painter->setPen(option.palette.color(QPalette::Text));
+        if (nameFm.horizontalAdvance(name) <= nameRect.width()) {
+            painter->drawText(nameRect, Qt::AlignLeft | Qt::AlignTop, name);
+        } else {
+            int split = name.size();
+            while (split > 0 && nameFm.horizontalAdvance(name.left(split)) > nameRect.width()) {
+                split = name.lastIndexOf(' ', split - 1);
+            }
+            if (split <= 0) {
+                split = name.size();  // No space to break at, elide a single line
+            }
+            const QString firstLine = nameFm.elidedText(name.left(split), Qt::ElideRight, nameRect.width());
+            const QString secondLine = nameFm.elidedText(name.mid(split).trimmed(), Qt::ElideRight,
+                                                         nameRect.width());
+            painter->drawText(nameRect.x(), nameRect.y() + nameFm.ascent(), firstLine);
+            painter->drawText(nameRect.x(), nameRect.y() + nameFm.height() + nameFm.ascent(), secondLine);
+        }
+
+        QStringList infoLines;
+        const QString author = index.data(WallpaperGridModel::AuthorRole).toString();
+        const QString type = index.data(WallpaperGridModel::TypeRole).toString();
+        if (!author.isEmpty()) {
+            infoLines << QString("By: %1").arg(author);
+        }
+        if (!type.isEmpty()) {
+            infoLines << QString("Type: %1").arg(type);
+        }
+
+        const QString infoText = infoLines.join(" • ");
+        const int infoY = nameRect.bottom() + 1 + textMargin / 2;
+        if (!infoText.isEmpty() && infoY < textRect.bottom()) {
+            QFont infoFont = option.font;
+            infoFont.setPointSize(qMax(7, option.font.pointSize() - 1));
+            const QFontMetrics infoFm(infoFont);
+            painter->setFont(infoFont);
+            painter->setPen(option.palette.color(QPalette::Mid));
+            painter->drawText(QRect(textRect.x(), infoY, textRect.width(), textRect.bottom() - infoY),
+                              Qt::AlignLeft | Qt::AlignTop,
+                              infoFm.elidedText(infoText, Qt::ElideRight, textRect.width()));
+        }
+    }
+
+    painter->restore();
+}
+
+QSize WallpaperGridDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    Q_UNUSED(option)
+    Q_UNUSED(index)
+    return QSize(WallpaperPreviewItem::ITEM_WIDTH, WallpaperPreviewItem::ITEM_HEIGHT);
+}
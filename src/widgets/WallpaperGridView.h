@@ -0,0 +1,73 @@
+#ifndef WALLPAPERGRIDVIEW_H
+#define WALLPAPERGRIDVIEW_H
+
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include "../core/WallpaperInfo.h"
+
+// Model behind the virtualized wallpaper grid. Rows are shared WallpaperInfo handles;
+// thumbnails are not stored here but looked up in ThumbnailCache when a row is painted,
+// so only rows that scroll into view are ever decoded and memory stays bounded by the
+// cache budget however large the library is.
+class WallpaperGridModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        AuthorRole,
+        TypeRole,
+        PlaceholderColorRole,  // Dominant preview colour as QRgb, 0 if unknown
+    };
+
+    explicit WallpaperGridModel(QObject* parent = nullptr);
+    ~WallpaperGridModel() override;
+
+    void setWallpapers(const QList<WallpaperInfoPtr>& wallpapers);
+    void updateWallpaper(const WallpaperInfoPtr& wallpaper, WallpaperInfo::Fields changed);
+    WallpaperInfoPtr wallpaperAt(int row) const;  // Null handle when out of range
+    int rowOf(const QString& wallpaperId) const;
+
+    // Drops queued decodes for rows outside [firstRow, lastRow] after a fast scroll
+    void retainThumbnails(int firstRow, int lastRow);
+
+    // Ratio of the screen the view is on; thumbnails are looked up and decoded for it
+    void setDevicePixelRatio(qreal ratio);
+    qreal devicePixelRatio() const { return m_devicePixelRatio; }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QStringList mimeTypes() const override;
+    QMimeData* mimeData(const QModelIndexList& indexes) const override;
+
+private:
+    void requestThumbnail(const WallpaperInfoPtr& wallpaper) const;
+    void cancelThumbnails();
+
+    QList<WallpaperInfoPtr> m_wallpapers;
+    QHash<QString, int> m_rows;
+    qreal m_devicePixelRatio;
+
+    // Requested from data(), which is const
+    mutable QHash<QString, quint64> m_pendingThumbnails;  // Wallpaper id -> loader ticket
+    mutable QSet<QString> m_failedThumbnails;             // Not retried until the preview changes
+};
+
+// Paints a tile the way WallpaperPreviewItem does, without a widget per wallpaper
+class WallpaperGridDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit WallpaperGridDelegate(QObject* parent = nullptr);
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+};
+
+#endif // WALLPAPERGRIDVIEW_H
@@ -1,6 +1,10 @@
 #include "WallpaperPreview.h"
+#include "WallpaperGridView.h"
 #include "../core/ConfigManager.h"
 #include "../addons/WNELAddon.h"  // Add WNEL addon include
+#include "../thumbnails/ThumbnailLoader.h"
+#include "../thumbnails/ThumbnailCache.h"
+#include "../thumbnails/PreviewAnimator.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -34,6 +38,7 @@
 #include <QRandomGenerator>
 #include <QApplication>
 #include <QDrag>
+#include <QWindow>
 #include <QMimeData>
 #include <QCursor>
 
@@ -52,7 +57,9 @@ WallpaperPreviewItem::WallpaperPreviewItem(const WallpaperInfo& wallpaper, QWidg
     , m_authorLabel(nullptr)
     , m_selected(false)
     , m_workshopDataLoaded(false)
-    , m_previewMovie(nullptr)
+    , m_thumbnailTicket(0)
+    , m_requestedRatio(0.0)
+    , m_animationHandle(0)
     , m_useCustomPainting(true)
     , m_cancelled(false)  // Initialize cancellation flag for animations
     , m_workshopDataCancelled(false)  // Initialize cancellation flag for workshop data
@@ -93,12 +100,92 @@ void WallpaperPreviewItem::loadPreviewImage()
             return;
         }
         
-        // Load static image
-        QPixmap pixmap(m_wallpaper.previewPath);
-        if (!pixmap.isNull()) {
+        loadStaticPreview();
+    }
+}
+
+void WallpaperPreviewItem::loadStaticPreview()
+{
+    // Static previews are decoded and scaled on a worker, building a page never waits on them
+    ThumbnailLoader& loader = ThumbnailLoader::instance();
+    loader.cancel(m_thumbnailTicket);
+    m_requestedRatio = devicePixelRatioF();
+    const QString previewPath = m_wallpaper.previewPath;
+    m_thumbnailTicket = loader.request(m_wallpaper.id, previewPath, QSize(PREVIEW_WIDTH, PREVIEW_HEIGHT),
+                                       devicePixelRatioF(), this, [this, previewPath](const QPixmap& pixmap) {
+        m_thumbnailTicket = 0;
+        if (!pixmap.isNull() && previewPath == m_wallpaper.previewPath) {
             setPreviewPixmap(pixmap);
         }
+    });
+}
+
+void WallpaperPreviewItem::cancelPreviewLoading()
+{
+    if (m_thumbnailTicket) {
+        ThumbnailLoader::instance().cancel(m_thumbnailTicket);
+        m_thumbnailTicket = 0;
+    }
+    releaseAnimation();
+}
+
+void WallpaperPreviewItem::releaseAnimation()
+{
+    if (m_animationHandle) {
+        PreviewAnimator::instance().detach(m_animationHandle);
+        m_animationHandle = 0;
+    }
+}
+
+void WallpaperPreviewItem::updateWallpaperInfo(const WallpaperInfo& wallpaper, WallpaperInfo::Fields changed)
+{
+    // Take only what changed on disk so workshop data fetched for this tile survives
+    if (changed & WallpaperInfo::NameField) {
+        m_wallpaper.name = wallpaper.name;
     }
+    if (changed & WallpaperInfo::AuthorField) {
+        m_wallpaper.author = wallpaper.author;
+        m_wallpaper.authorId = wallpaper.authorId;
+    }
+    if (changed & WallpaperInfo::DescriptionField) {
+        m_wallpaper.description = wallpaper.description;
+    }
+    if (changed & WallpaperInfo::TypeField) {
+        m_wallpaper.type = wallpaper.type;
+    }
+    if (changed & WallpaperInfo::TagsField) {
+        m_wallpaper.tags = wallpaper.tags;
+    }
+    if (changed & WallpaperInfo::DatesField) {
+        m_wallpaper.created = wallpaper.created;
+        m_wallpaper.updated = wallpaper.updated;
+    }
+    if (changed & WallpaperInfo::FileSizeField) {
+        m_wallpaper.fileSize = wallpaper.fileSize;
+    }
+    if (changed & WallpaperInfo::LocationField) {
+        m_wallpaper.path = wallpaper.path;
+        m_wallpaper.projectPath = wallpaper.projectPath;
+    }
+    if (changed & WallpaperInfo::PropertiesField) {
+        m_wallpaper.properties = wallpaper.properties;
+    }
+    
+    if (changed & WallpaperInfo::PreviewField) {
+        bool wasPlaying = isAnimationPlaying();
+        releaseAnimation();
+        
+        m_wallpaper.previewPath = wallpaper.previewPath;
+        m_scaledPreview = QPixmap();
+        ThumbnailLoader::instance().invalidate(m_wallpaper.id, m_wallpaper.previewPath);
+        loadPreviewImage();
+        
+        if (wasPlaying) {
+            startAnimation();
+        }
+    }
+    
+    update();
 }
 
 void WallpaperPreviewItem::setPreviewPixmap(const QPixmap& pixmap)
@@ -113,80 +200,42 @@ void WallpaperPreviewItem::setPreviewPixmap(const QPixmap& pixmap)
 
 QPixmap WallpaperPreviewItem::scalePreviewKeepAspectRatio(const QPixmap& original)
 {
-    QSize containerSize(PREVIEW_WIDTH, PREVIEW_HEIGHT);
+    // Thumbnails come in physical pixels for the screen they were requested for
+    const qreal ratio = original.devicePixelRatio();
+    QSize containerSize = ThumbnailLoader::pixelSize(QSize(PREVIEW_WIDTH, PREVIEW_HEIGHT), ratio);
     QSize scaledSize = calculateFitSize(original.size(), containerSize);
     
-    return original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QPixmap scaled = original.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    scaled.setDevicePixelRatio(ratio);
+    return scaled;
 }
 
 void WallpaperPreviewItem::loadAnimatedPreview()
 {
-    if (m_cancelled || !hasAnimatedPreview()) {
+    if (m_cancelled || !hasAnimatedPreview() || m_animationHandle) {
         return;
     }
     
-    // Clean up existing movie if any
-    if (m_previewMovie) {
-        m_previewMovie->stop();
-        m_previewMovie->deleteLater();
-        m_previewMovie = nullptr;
-    }
-    
-    // Create and configure QMovie for animation
-    m_previewMovie = new QMovie(m_wallpaper.previewPath, QByteArray(), this);
-    
-    if (!m_previewMovie->isValid()) {
-        qCWarning(wallpaperPreview) << "Invalid animated preview file:" << m_wallpaper.previewPath;
-        m_previewMovie->deleteLater();
-        m_previewMovie = nullptr;
-        // Fall back to static image - load directly to avoid recursion
-        QPixmap staticPixmap(m_wallpaper.previewPath);
-        if (!staticPixmap.isNull()) {
-            setPreviewPixmap(staticPixmap);
-        }
-        return;
-    }
-    
-    // Connect to movie signals for frame updates
-    connect(m_previewMovie, &QMovie::frameChanged, this, [this](int frameNumber) {
-        Q_UNUSED(frameNumber)
-        if (m_previewMovie && !m_cancelled) {
-            QPixmap currentFrame = m_previewMovie->currentPixmap();
-            if (!currentFrame.isNull()) {
-                m_scaledPreview = scalePreviewKeepAspectRatio(currentFrame);
-                update();
-                // Debug output for first few frames to avoid spam
-                if (frameNumber < 5) {
-                    qCDebug(wallpaperPreview) << "Frame" << frameNumber << "updated for:" << m_wallpaper.name;
-                }
-            }
+    // Frames are decoded once at tile size on a worker and shared with every other view of
+    // this wallpaper; the first one arrives through the callback as soon as it is ready
+    const QString previewPath = m_wallpaper.previewPath;
+    m_animationHandle = PreviewAnimator::instance().attach(m_wallpaper.id, previewPath,
+                                                           QSize(PREVIEW_WIDTH, PREVIEW_HEIGHT), this,
+                                                           [this, previewPath](const QPixmap& frame) {
+        if (m_cancelled || previewPath != m_wallpaper.previewPath) {
+            return;
         }
-    });
-    
-    connect(m_previewMovie, &QMovie::error, this, [this](QImageReader::ImageReaderError error) {
-        qCWarning(wallpaperPreview) << "Movie error:" << error << "for file:" << m_wallpaper.previewPath;
-        // Fall back to static preview - load directly to avoid recursion
-        QPixmap staticPixmap(m_wallpaper.previewPath);
-        if (!staticPixmap.isNull()) {
-            setPreviewPixmap(staticPixmap);
+        if (frame.isNull()) {
+            qCWarning(wallpaperPreview) << "Invalid animated preview file:" << previewPath;
+            // Nothing to play, so the tile must not keep asking for a playing slot
+            releaseAnimation();
+            loadStaticPreview();
+            return;
         }
+        m_scaledPreview = frame;
+        update();
     });
     
-    // Get the first frame by jumping to frame 0
-    m_previewMovie->jumpToFrame(0);
-    QPixmap firstFrame = m_previewMovie->currentPixmap();
-    if (!firstFrame.isNull()) {
-        m_scaledPreview = scalePreviewKeepAspectRatio(firstFrame);
-        update(); // Ensure the UI shows the first frame immediately
-    } else {
-        // If we can't get the first frame, try loading as static image fallback
-        QPixmap staticPixmap(m_wallpaper.previewPath);
-        if (!staticPixmap.isNull()) {
-            m_scaledPreview = scalePreviewKeepAspectRatio(staticPixmap);
-            update();
-        }
-    }
-    
     // Don't start playing immediately - wait for page visibility
     qCDebug(wallpaperPreview) << "Loaded animated preview for:" << m_wallpaper.name;
 }
@@ -210,30 +259,27 @@ bool WallpaperPreviewItem::hasAnimatedPreview() const
 
 void WallpaperPreviewItem::startAnimation()
 {
-    if (m_previewMovie && m_previewMovie->isValid() && !m_cancelled) {
-        qCDebug(wallpaperPreview) << "Starting animation for:" << m_wallpaper.name 
-                                  << "Movie state:" << m_previewMovie->state()
-                                  << "Frame count:" << m_previewMovie->frameCount();
-        m_previewMovie->start();
-        qCDebug(wallpaperPreview) << "Animation started, new state:" << m_previewMovie->state();
+    if (m_animationHandle && !m_cancelled) {
+        qCDebug(wallpaperPreview) << "Starting animation for:" << m_wallpaper.name;
+        PreviewAnimator::instance().setPlaying(m_animationHandle, true);
     } else {
         qCDebug(wallpaperPreview) << "Cannot start animation for:" << m_wallpaper.name 
-                                  << "Movie valid:" << (m_previewMovie && m_previewMovie->isValid())
+                                  << "Animation loaded:" << (m_animationHandle != 0)
                                   << "Cancelled:" << m_cancelled;
     }
 }
 
 void WallpaperPreviewItem::stopAnimation()
 {
-    if (m_previewMovie && m_previewMovie->isValid()) {
+    if (m_animationHandle) {
         qCDebug(wallpaperPreview) << "Stopping animation for:" << m_wallpaper.name;
-        m_previewMovie->stop();
+        PreviewAnimator::instance().setPlaying(m_animationHandle, false);
     }
 }
 
 bool WallpaperPreviewItem::isAnimationPlaying() const
 {
-    return m_previewMovie && m_previewMovie->state() == QMovie::Running;
+    return m_animationHandle && PreviewAnimator::instance().isPlaying(m_animationHandle);
 }
 
 QSize WallpaperPreviewItem::calculateFitSize(const QSize& imageSize, const QSize& containerSize)
@@ -600,12 +646,19 @@ void WallpaperPreviewItem::paintEvent(QPaintEvent* event)
     int previewWidth = qMin(PREVIEW_WIDTH, availableWidth);
     
     if (!m_scaledPreview.isNull()) {
+        // Moved to a screen with another scale factor: swap in the thumbnail variant made for it
+        // Compared with the last request, not the pixmap, so a failed decode is not retried on every paint
+        if (!m_animationHandle && !m_thumbnailTicket && !qFuzzyCompare(m_requestedRatio, devicePixelRatioF())) {
+            QMetaObject::invokeMethod(this, &WallpaperPreviewItem::loadStaticPreview, Qt::QueuedConnection);
+        }
+        
         QRect previewRect = QRect(PREVIEW_CONTAINER_MARGIN, PREVIEW_CONTAINER_MARGIN, 
                                  previewWidth, previewHeight);
         
+        const QSize previewSize = m_scaledPreview.deviceIndependentSize().toSize();
         QRect imageRect = previewRect;
-        if (m_scaledPreview.size() != previewRect.size()) {
-            QSize scaledSize = m_scaledPreview.size().scaled(previewRect.size(), Qt::KeepAspectRatio);
+        if (previewSize != previewRect.size()) {
+            QSize scaledSize = previewSize.scaled(previewRect.size(), Qt::KeepAspectRatio);
             imageRect = QRect(
                 previewRect.x() + (previewRect.width() - scaledSize.width()) / 2,
                 previewRect.y() + (previewRect.height() - scaledSize.height()) / 2,
@@ -620,9 +673,14 @@ void WallpaperPreviewItem::paintEvent(QPaintEvent* event)
                                  previewWidth, previewHeight);
         
         if (previewRect.width() > 0 && previewRect.height() > 0) {
-            painter.fillRect(previewRect, QColor(60, 60, 60));
-            painter.setPen(QColor(120, 120, 120));
-            painter.drawText(previewRect, Qt::AlignCenter, "Loading...");
+            // The scan's dominant colour stands in until the thumbnail is decoded
+            if (m_wallpaper.placeholderColor != 0) {
+                painter.fillRect(previewRect, QColor::fromRgb(m_wallpaper.placeholderColor));
+            } else {
+                painter.fillRect(previewRect, QColor(60, 60, 60));
+                painter.setPen(QColor(120, 120, 120));
+                painter.drawText(previewRect, Qt::AlignCenter, "Loading...");
+            }
         }
     }
     
@@ -646,7 +704,7 @@ void WallpaperPreviewItem::paintEvent(QPaintEvent* event)
         int maxNameLines = qMax(1, qMin(3, maxTextHeight / nameLineHeight - 2));
         
         QRect nameRect = QRect(textRect.x(), textRect.y(), textRect.width(), nameLineHeight * maxNameLines);
-        drawTextWithWordWrap(painter, displayName, nameRect, nameFont, palette().color(QPalette::Text));
+        drawTextWithWordWrap(painter, m_nameText, displayName, nameRect, nameFont, palette().color(QPalette::Text));
         
         QFont infoFont = font();
         infoFont.setPointSize(qMax(7, font().pointSize() - 1));
@@ -666,22 +724,43 @@ void WallpaperPreviewItem::paintEvent(QPaintEvent* event)
             QString infoText = infoLines.join(" • ");
             if (!infoText.isEmpty()) {
                 painter.setPen(palette().color(QPalette::Mid));
-                drawTextWithWordWrap(painter, infoText, infoRect, infoFont, palette().color(QPalette::Mid));
+                drawTextWithWordWrap(painter, m_infoText, infoText, infoRect, infoFont, palette().color(QPalette::Mid));
             }
         }
     }
 }
 
-void WallpaperPreviewItem::drawTextWithWordWrap(QPainter& painter, const QString& text, const QRect& rect, 
-                                               const QFont& font, const QColor& color, Qt::Alignment alignment)
+void WallpaperPreviewItem::drawTextWithWordWrap(QPainter& painter, WrappedText& cache, const QString& text,
+                                               const QRect& rect, const QFont& font, const QColor& color,
+                                               Qt::Alignment alignment)
 {
     if (text.isEmpty() || rect.isEmpty()) {
         return;
     }
     
+    // Hover, selection and animation frames repaint the tile without changing its text
+    if (cache.text != text || cache.font != font || cache.size != rect.size() || cache.alignment != alignment) {
+        layoutWrappedText(cache, text, rect.size(), font, alignment);
+    }
+    
     painter.setFont(font);
     painter.setPen(color);
     
+    for (int i = 0; i < cache.lines.size(); ++i) {
+        painter.drawStaticText(rect.topLeft() + cache.offsets.at(i), cache.lines.at(i));
+    }
+}
+
+void WallpaperPreviewItem::layoutWrappedText(WrappedText& cache, const QString& text, const QSize& size,
+                                            const QFont& font, Qt::Alignment alignment)
+{
+    cache.text = text;
+    cache.font = font;
+    cache.size = size;
+    cache.alignment = alignment;
+    cache.lines.clear();
+    cache.offsets.clear();
+    
     QFontMetrics fm(font);
     QStringList words = text.split(' ', Qt::SkipEmptyParts);
     
@@ -695,14 +774,14 @@ void WallpaperPreviewItem::drawTextWithWordWrap(QPainter& painter, const QString
     for (const QString& word : words) {
         QString testLine = currentLine.isEmpty() ? word : currentLine + " " + word;
         
-        if (fm.horizontalAdvance(testLine) <= rect.width()) {
+        if (fm.horizontalAdvance(testLine) <= size.width()) {
             currentLine = testLine;
         } else {
             if (!currentLine.isEmpty()) {
                 lines.append(currentLine);
                 currentLine = word;
             } else {
-                currentLine = fm.elidedText(word, Qt::ElideRight, rect.width());
+                currentLine = fm.elidedText(word, Qt::ElideRight, size.width());
                 lines.append(currentLine);
                 currentLine.clear();
             }
@@ -714,33 +793,41 @@ void WallpaperPreviewItem::drawTextWithWordWrap(QPainter& painter, const QString
     }
     
     int lineHeight = fm.height();
-    int maxLines = qMax(1, rect.height() / lineHeight);
+    int maxLines = qMax(1, size.height() / lineHeight);
     
     if (lines.size() > maxLines) {
         lines = lines.mid(0, maxLines);
         if (!lines.isEmpty()) {
             QString& lastLine = lines.last();
-            lastLine = fm.elidedText(lastLine, Qt::ElideRight, rect.width());
+            lastLine = fm.elidedText(lastLine, Qt::ElideRight, size.width());
         }
     }
     
-    int startY = rect.y();
+    int startY = 0;
     if (alignment & Qt::AlignVCenter) {
         int usedHeight = lines.size() * lineHeight;
-        startY = rect.y() + (rect.height() - usedHeight) / 2;
+        startY = (size.height() - usedHeight) / 2;
     } else if (alignment & Qt::AlignBottom) {
         int usedHeight = lines.size() * lineHeight;
-        startY = rect.bottom() - usedHeight;
+        startY = size.height() - 1 - usedHeight;
     }
     
+    Qt::Alignment hAlign = alignment & Qt::AlignHorizontal_Mask;
     for (int i = 0; i < lines.size(); ++i) {
-        QString line = lines[i];
-        QRect lineRect = QRect(rect.x(), startY + i * lineHeight, rect.width(), lineHeight);
+        QStaticText line(lines[i]);
+        line.setTextFormat(Qt::PlainText);
+        line.prepare(QTransform(), font);
         
-        Qt::Alignment hAlign = alignment & Qt::AlignHorizontal_Mask;
-        if (hAlign == 0) hAlign = Qt::AlignLeft;
+        int x = 0;
+        int lineWidth = fm.horizontalAdvance(lines[i]);
+        if (hAlign & Qt::AlignRight) {
+            x = size.width() - lineWidth;
+        } else if (hAlign & Qt::AlignHCenter) {
+            x = (size.width() - lineWidth) / 2;
+        }
         
-        painter.drawText(lineRect, hAlign | Qt::AlignVCenter, line);
+        cache.lines.append(line);
+        cache.offsets.append(QPoint(x, startY + i * lineHeight));
     }
 }
 
@@ -1097,6 +1184,9 @@ WallpaperPreview::WallpaperPreview(QWidget* parent)
     , m_scrollArea(nullptr)
     , m_gridWidget(nullptr)
     , m_gridLayout(nullptr)
+    , m_gridView(nullptr)
+    , m_gridModel(nullptr)
+    , m_virtualizedGrid(ConfigManager::instance().virtualizedGridEnabled())
     , m_paginationWidget(nullptr)
     , m_prevPageButton(nullptr)
     , m_nextPageButton(nullptr)
@@ -1107,6 +1197,9 @@ WallpaperPreview::WallpaperPreview(QWidget* parent)
     , m_workshopLoadTimer(new QTimer(this))
     , m_pendingItemIndex(0)
     , m_workshopBatchIndex(0)
+    , m_prefetchTimer(new QTimer(this))
+    , m_animationTimer(new QTimer(this))
+    , m_animationsSuspended(false)
     , m_currentItemsPerRow(PREFERRED_ITEMS_PER_ROW)
     , m_lastContainerWidth(0)
     , m_layoutUpdatePending(false)
@@ -1120,6 +1213,12 @@ WallpaperPreview::WallpaperPreview(QWidget* parent)
     
     connect(m_workshopLoadTimer, &QTimer::timeout, this, &WallpaperPreview::loadWorkshopDataBatch);
     m_workshopLoadTimer->setSingleShot(false);
+    
+    m_prefetchTimer->setSingleShot(true);
+    connect(m_prefetchTimer, &QTimer::timeout, this, &WallpaperPreview::prefetchAdjacentPages);
+    
+    m_animationTimer->setSingleShot(true);
+    connect(m_animationTimer, &QTimer::timeout, this, &WallpaperPreview::updateVisibleAnimations);
 }
 
 void WallpaperPreview::setupUI()
@@ -1169,9 +1268,56 @@ void WallpaperPreview::setupUI()
     m_scrollArea->setWidget(m_gridWidget);
     mainLayout->addWidget(m_scrollArea);
     
+    // Tiles scrolled out of the viewport stop animating
+    connect(m_scrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, [this]() { scheduleAnimationUpdate(); });
+    connect(m_scrollArea->horizontalScrollBar(), &QScrollBar::valueChanged,
+            this, [this]() { scheduleAnimationUpdate(); });
+    
+    // Virtualized grid: the view only asks the model and delegate for rows in the viewport
+    m_gridModel = new WallpaperGridModel(this);
+    m_gridView = new QListView;
+    m_gridView->setViewMode(QListView::IconMode);
+    m_gridView->setFlow(QListView::LeftToRight);
+    m_gridView->setWrapping(true);
+    m_gridView->setResizeMode(QListView::Adjust);
+    m_gridView->setMovement(QListView::Static);
+    m_gridView->setUniformItemSizes(true);
+    m_gridView->setGridSize(QSize(WallpaperPreviewItem::ITEM_WIDTH + ITEM_SPACING,
+                                  WallpaperPreviewItem::ITEM_HEIGHT + ITEM_SPACING));
+    m_gridView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_gridView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_gridView->setDragEnabled(true);
+    m_gridView->setDragDropMode(QAbstractItemView::DragOnly);
+    m_gridView->setDefaultDropAction(Qt::CopyAction);
+    m_gridView->setContextMenuPolicy(Qt::CustomContextMenu);
+    m_gridView->setItemDelegate(new WallpaperGridDelegate(m_gridView));
+    m_gridView->setModel(m_gridModel);
+    
+    connect(m_gridView, &QListView::pressed, this, [this](const QModelIndex& index) {
+        WallpaperInfoPtr wallpaper = m_gridModel->wallpaperAt(index.row());
+        if (wallpaper) {
+            onWallpaperItemClicked(*wallpaper);
+        }
+    });
+    connect(m_gridView, &QListView::doubleClicked, this, [this](const QModelIndex& index) {
+        WallpaperInfoPtr wallpaper = m_gridModel->wallpaperAt(index.row());
+        if (wallpaper) {
+            onWallpaperItemDoubleClicked(*wallpaper);
+        }
+    });
+    connect(m_gridView, &QListView::customContextMenuRequested,
+            this, &WallpaperPreview::showGridContextMenu);
+    connect(m_gridView->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &WallpaperPreview::onGridViewScrolled);
+    mainLayout->addWidget(m_gridView);
+    
     // Pagination controls
     setupPagination();
     mainLayout->addWidget(m_paginationWidget);
+    
+    m_scrollArea->setVisible(!m_virtualizedGrid);
+    m_gridView->setVisible(m_virtualizedGrid);
 }
 
 void WallpaperPreview::setupPagination()
@@ -1202,7 +1348,14 @@ void WallpaperPreview::setWallpaperManager(WallpaperManager* manager)
     if (m_wallpaperManager) {
         connect(m_wallpaperManager, &WallpaperManager::wallpapersChanged,
                 this, &WallpaperPreview::onWallpapersChanged);
+        connect(m_wallpaperManager, &WallpaperManager::wallpapersAdded,
+                this, &WallpaperPreview::onWallpapersAddedOrRemoved);
+        connect(m_wallpaperManager, &WallpaperManager::wallpapersRemoved,
+                this, &WallpaperPreview::onWallpapersAddedOrRemoved);
+        connect(m_wallpaperManager, &WallpaperManager::wallpaperUpdated,
+                this, &WallpaperPreview::onWallpaperUpdated);
     }
+    rebuildSearchIndex();
 }
 
 void WallpaperPreview::setWNELAddon(WNELAddon* wnelAddon)
@@ -1220,10 +1373,129 @@ void WallpaperPreview::setWNELAddon(WNELAddon* wnelAddon)
 void WallpaperPreview::onWallpapersChanged()
 {
     qCDebug(wallpaperPreview) << "onWallpapersChanged - refreshing grid";
+    rebuildSearchIndex();
     m_currentPage = 0;
     updateWallpaperGrid();
 }
 
+void WallpaperPreview::onWallpapersAddedOrRemoved(const QStringList& ids)
+{
+    qCDebug(wallpaperPreview) << "Library added or removed" << ids.size() << "wallpapers";
+    for (const QString& id : ids) {
+        WallpaperInfoPtr wallpaper = m_wallpaperManager ? m_wallpaperManager->findWallpaper(id) : WallpaperInfoPtr();
+        if (wallpaper) {
+            m_searchIndex.insert(*wallpaper);
+        } else {
+            m_searchIndex.remove(id);
+        }
+    }
+    reconcileCurrentPage();
+}
+
+void WallpaperPreview::onWallpaperUpdated(const QString& id, WallpaperInfo::Fields changed)
+{
+    if (!m_wallpaperManager) {
+        return;
+    }
+    
+    WallpaperInfoPtr wallpaper = m_wallpaperManager->findWallpaper(id);
+    if (!wallpaper) {
+        return;
+    }
+    
+    const WallpaperInfo::Fields searchFields = WallpaperInfo::NameField | WallpaperInfo::DescriptionField
+        | WallpaperInfo::AuthorField | WallpaperInfo::TagsField;
+    if (changed & searchFields) {
+        m_searchIndex.insert(*wallpaper);
+    }
+    
+    // Only the searched fields and the type take part in filtering; if the page was
+    // rebuilt because of them the new tiles already carry the update
+    const WallpaperInfo::Fields filterFields = searchFields | WallpaperInfo::TypeField;
+    if ((changed & filterFields) && reconcileCurrentPage()) {
+        return;
+    }
+    
+    for (WallpaperInfoPtr& filtered : m_filteredWallpapers) {
+        if (filtered->id == id) {
+            filtered = wallpaper;
+            break;
+        }
+    }
+    
+    for (WallpaperPreviewItem* item : m_currentPageItems) {
+        if (item && item->wallpaperInfo().id == id) {
+            item->updateWallpaperInfo(*wallpaper, changed);
+            break;
+        }
+    }
+    
+    if (m_virtualizedGrid) {
+        m_gridModel->updateWallpaper(wallpaper, changed);
+    }
+}
+
+bool WallpaperPreview::reconcileCurrentPage()
+{
+    // Library updates keep the current page and only rebuild it when its tiles change
+    QStringList pageIdsBefore;
+    for (WallpaperPreviewItem* item : m_currentPageItems) {
+        if (item) {
+            pageIdsBefore.append(item->wallpaperInfo().id);
+        }
+    }
+    QString selectedId = getSelectedWallpaperId();
+    
+    m_filteredWallpapers = getFilteredWallpapers();
+    
+    if (m_virtualizedGrid) {
+        // No pages here; the model is only reset when the set or order of rows changed
+        bool rowsChanged = m_filteredWallpapers.size() != m_gridModel->rowCount();
+        for (int i = 0; !rowsChanged && i < m_filteredWallpapers.size(); ++i) {
+            rowsChanged = m_filteredWallpapers[i]->id != m_gridModel->wallpaperAt(i)->id;
+        }
+        if (rowsChanged) {
+            qCDebug(wallpaperPreview) << "Library change affects the grid, resetting its model";
+            m_gridModel->setWallpapers(m_filteredWallpapers);
+            if (!selectedId.isEmpty()) {
+                selectWallpaper(selectedId);
+            }
+        }
+        updatePageInfo();
+        return rowsChanged;
+    }
+    
+    m_totalPages = qMax(1, (m_filteredWallpapers.size() + ITEMS_PER_PAGE - 1) / ITEMS_PER_PAGE);
+    if (m_currentPage >= m_totalPages) {
+        m_currentPage = qMax(0, m_totalPages - 1);
+    }
+    
+    QStringList pageIdsAfter;
+    int startIndex = m_currentPage * ITEMS_PER_PAGE;
+    int endIndex = qMin(startIndex + ITEMS_PER_PAGE, m_filteredWallpapers.size());
+    for (int i = startIndex; i < endIndex; ++i) {
+        pageIdsAfter.append(m_filteredWallpapers[i]->id);
+    }
+    
+    bool pageAffected = pageIdsBefore != pageIdsAfter;
+    if (pageAffected) {
+        qCDebug(wallpaperPreview) << "Library change affects current page, reloading it";
+        clearCurrentPage();
+        loadCurrentPage();
+        
+        for (WallpaperPreviewItem* item : m_currentPageItems) {
+            if (item && item->wallpaperInfo().id == selectedId) {
+                item->setSelected(true);
+                m_selectedItem = item;
+                break;
+            }
+        }
+    }
+    
+    updatePageInfo();
+    return pageAffected;
+}
+
 void WallpaperPreview::onSearchTextChanged(const QString& text)
 {
     Q_UNUSED(text)
@@ -1247,8 +1519,8 @@ void WallpaperPreview::onRefreshClicked()
 
 void WallpaperPreview::onApplyClicked()
 {
-    if (m_selectedItem) {
-        emit wallpaperDoubleClicked(m_selectedItem->wallpaperInfo());
+    if (!getSelectedWallpaperId().isEmpty()) {
+        emit wallpaperDoubleClicked(getSelectedWallpaper());
     }
 }
 
@@ -1277,38 +1549,43 @@ void WallpaperPreview::onWallpaperItemDoubleClicked(const WallpaperInfo& wallpap
     }
 }
 
-QList<WallpaperInfo> WallpaperPreview::getFilteredWallpapers() const
+QList<WallpaperInfoPtr> WallpaperPreview::getFilteredWallpapers() const
 {
-    QList<WallpaperInfo> allWallpapers;
+    // Handles only: filtering and paging never copy descriptions, tags or properties
+    QList<WallpaperInfoPtr> allWallpapers;
     
     // Get regular wallpapers from WallpaperManager
     if (m_wallpaperManager) {
-        allWallpapers = m_wallpaperManager->getAllWallpapers();
+        allWallpapers = m_wallpaperManager->wallpapers();
     }
     
     // Get external wallpapers from WNELAddon
     if (m_wnelAddon && m_wnelAddon->isEnabled()) {
         QList<ExternalWallpaperInfo> externalWallpapers = m_wnelAddon->getAllExternalWallpapers();
         for (const ExternalWallpaperInfo& external : externalWallpapers) {
-            allWallpapers.append(external.toWallpaperInfo());
+            allWallpapers.append(makeWallpaperInfoPtr(external.toWallpaperInfo()));
         }
     }
     
-    QList<WallpaperInfo> filtered;
+    QList<WallpaperInfoPtr> filtered;
+    filtered.reserve(allWallpapers.size());
     
-    QString searchText = m_searchEdit->text().toLower();
+    QString searchText = m_searchEdit->text();
     QString filterType = m_filterCombo->currentText();
     
-    for (const WallpaperInfo& wallpaper : allWallpapers) {
-        bool matchesSearch = searchText.isEmpty() || 
-                           wallpaper.name.toLower().contains(searchText) ||
-                           wallpaper.description.toLower().contains(searchText);
+    // Library hits come from the index's posting lists; the few external wallpapers are not
+    // indexed and are matched directly
+    const QSet<QString> searchHits = searchText.isEmpty() ? QSet<QString>() : m_searchIndex.search(searchText);
+    
+    for (const WallpaperInfoPtr& wallpaper : allWallpapers) {
+        bool matchesSearch = searchText.isEmpty() || searchHits.contains(wallpaper->id)
+            || (!m_searchIndex.contains(wallpaper->id) && WallpaperSearchIndex::matches(*wallpaper, searchText));
         
         bool matchesFilter = (filterType == "All Types") || 
-                           (wallpaper.type.compare(filterType, Qt::CaseInsensitive) == 0);
+                           (wallpaper->type.compare(filterType, Qt::CaseInsensitive) == 0);
         
         // Check hidden status filter
-        bool isHidden = m_hiddenWallpapers.contains(wallpaper.id);
+        bool isHidden = m_hiddenWallpapers.contains(wallpaper->id);
         bool matchesHiddenFilter = m_showHiddenWallpapers || !isHidden;
         
         if (matchesSearch && matchesFilter && matchesHiddenFilter) {
@@ -1319,6 +1596,20 @@ QList<WallpaperInfo> WallpaperPreview::getFilteredWallpapers() const
     return filtered;
 }
 
+void WallpaperPreview::rebuildSearchIndex()
+{
+    m_searchIndex.clear();
+    if (!m_wallpaperManager) {
+        return;
+    }
+    
+    const QList<WallpaperInfoPtr> wallpapers = m_wallpaperManager->wallpapers();
+    for (const WallpaperInfoPtr& wallpaper : wallpapers) {
+        m_searchIndex.insert(*wallpaper);
+    }
+    qCDebug(wallpaperPreview) << "Search index built for" << m_searchIndex.size() << "wallpapers";
+}
+
 void WallpaperPreview::updateWallpaperGrid()
 {
     // Prevent multiple concurrent updates
@@ -1332,13 +1623,20 @@ void WallpaperPreview::updateWallpaperGrid()
     clearCurrentPage();
     
     m_filteredWallpapers = getFilteredWallpapers();
-    m_totalPages = qMax(1, (m_filteredWallpapers.size() + ITEMS_PER_PAGE - 1) / ITEMS_PER_PAGE);
     
-    if (m_currentPage >= m_totalPages) {
-        m_currentPage = qMax(0, m_totalPages - 1);
+    if (m_virtualizedGrid) {
+        m_currentPage = 0;
+        m_totalPages = 1;
+        m_gridModel->setWallpapers(m_filteredWallpapers);
+    } else {
+        m_totalPages = qMax(1, (m_filteredWallpapers.size() + ITEMS_PER_PAGE - 1) / ITEMS_PER_PAGE);
+        
+        if (m_currentPage >= m_totalPages) {
+            m_currentPage = qMax(0, m_totalPages - 1);
+        }
+        
+        loadCurrentPage();
     }
-    
-    loadCurrentPage();
     updatePageInfo();
     
     m_layoutUpdatePending = false;
@@ -1353,7 +1651,7 @@ void WallpaperPreview::loadCurrentPage()
     int row = 0, col = 0;
     
     for (int i = startIndex; i < endIndex; ++i) {
-        WallpaperPreviewItem* item = new WallpaperPreviewItem(m_filteredWallpapers[i]);
+        WallpaperPreviewItem* item = new WallpaperPreviewItem(*m_filteredWallpapers[i]);
         
         connect(item, &WallpaperPreviewItem::clicked, 
                 this, &WallpaperPreview::onWallpaperItemClicked);
@@ -1377,15 +1675,11 @@ void WallpaperPreview::loadCurrentPage()
     
     startWallpaperDataLoading();
     
-    // Start animations for current page items after a short delay
+    // Start animations for the visible items after a short delay
     // This allows the UI to settle before starting resource-intensive animations
-    QTimer* animTimer = new QTimer(this);
-    animTimer->setSingleShot(true);
-    connect(animTimer, &QTimer::timeout, this, [this, animTimer]() {
-        startCurrentPageAnimations();
-        animTimer->deleteLater();
-    });
-    animTimer->start(200);
+    scheduleAnimationUpdate(ANIMATION_START_DELAY_MS);
+    
+    m_prefetchTimer->start(PREFETCH_DELAY_MS);
 }
 
 void WallpaperPreview::clearCurrentPage()
@@ -1394,6 +1688,7 @@ void WallpaperPreview::clearCurrentPage()
     m_workshopLoadTimer->stop();
     cancelAllPendingOperations();
     m_pendingWorkshopItems.clear();
+    cancelPrefetch();
     
     // Stop animations before clearing items
     stopCurrentPageAnimations();
@@ -1401,6 +1696,9 @@ void WallpaperPreview::clearCurrentPage()
     // Now it's safe to delete the items
     for (WallpaperPreviewItem* item : m_currentPageItems) {
         if (item) {
+            // deleteLater() only runs once control returns to the event loop; queued
+            // decodes for this page should not hold up the next one until then
+            item->cancelPreviewLoading();
             m_gridLayout->removeWidget(item);
             item->setParent(nullptr);
             item->deleteLater();
@@ -1410,20 +1708,40 @@ void WallpaperPreview::clearCurrentPage()
     m_selectedItem = nullptr;
 }
 
-void WallpaperPreview::startCurrentPageAnimations()
+void WallpaperPreview::scheduleAnimationUpdate(int delayMs)
+{
+    // An earlier, longer delay (a page that is still settling) is not cut short
+    if (!m_animationTimer->isActive() || m_animationTimer->remainingTime() < delayMs) {
+        m_animationTimer->start(delayMs);
+    }
+}
+
+void WallpaperPreview::updateVisibleAnimations()
 {
-    qCDebug(wallpaperPreview) << "Starting animations for current page items:" << m_currentPageItems.size();
+    // The grid view paints still thumbnails; a hidden tab or minimized window shows nothing
+    if (m_virtualizedGrid || m_animationsSuspended || !isVisible() || !m_gridWidget) {
+        stopCurrentPageAnimations();
+        return;
+    }
     
-    int animatedCount = 0;
+    // Item geometry is in m_gridWidget coordinates, which the scroll area moves under the viewport
+    const QRect visibleRect(-m_gridWidget->pos(), m_scrollArea->viewport()->size());
+    
+    int playing = 0;
     for (WallpaperPreviewItem* item : m_currentPageItems) {
-        if (item && item->hasAnimatedPreview()) {
-            animatedCount++;
-            qCDebug(wallpaperPreview) << "Starting animation for item:" << item->wallpaperInfo().name;
+        if (!item) {
+            continue;
+        }
+        if (item->geometry().intersects(visibleRect) && item->hasAnimatedPreview()) {
+            item->loadAnimatedPreview();  // No-op once attached
             item->startAnimation();
+            playing++;
+        } else if (item->isAnimationPlaying()) {
+            item->stopAnimation();
         }
     }
     
-    qCDebug(wallpaperPreview) << "Started animations for" << animatedCount << "items";
+    qCDebug(wallpaperPreview) << "Animating" << playing << "visible items of" << m_currentPageItems.size();
 }
 
 void WallpaperPreview::stopCurrentPageAnimations()
@@ -1439,6 +1757,13 @@ void WallpaperPreview::stopCurrentPageAnimations()
 
 void WallpaperPreview::updatePageInfo()
 {
+    m_prevPageButton->setVisible(!m_virtualizedGrid);
+    m_nextPageButton->setVisible(!m_virtualizedGrid);
+    if (m_virtualizedGrid) {
+        m_pageInfoLabel->setText(QString("%1 wallpapers").arg(m_filteredWallpapers.size()));
+        return;
+    }
+    
     m_pageInfoLabel->setText(QString("Page %1 of %2 (%3 wallpapers)")
                             .arg(m_currentPage + 1)
                             .arg(m_totalPages)
@@ -1515,6 +1840,37 @@ void WallpaperPreview::resizeEvent(QResizeEvent* event)
             layoutTimer->start(50);
         }
     }
+    
+    scheduleAnimationUpdate();
+}
+
+void WallpaperPreview::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    
+    // The native window exists from the first show on; follow it across monitors
+    if (QWindow* windowHandle = window()->windowHandle()) {
+        connect(windowHandle, &QWindow::screenChanged, this, &WallpaperPreview::onScreenChanged,
+                Qt::UniqueConnection);
+    }
+    onScreenChanged();
+    
+    // Also sent when the tab holding the grid becomes current again
+    scheduleAnimationUpdate();
+}
+
+void WallpaperPreview::onScreenChanged()
+{
+    // Widget tiles notice the new ratio when they repaint; the grid model is told here
+    m_gridModel->setDevicePixelRatio(devicePixelRatioF());
+}
+
+void WallpaperPreview::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+    
+    m_animationTimer->stop();
+    stopCurrentPageAnimations();
 }
 
 void WallpaperPreview::recalculateLayout()
@@ -1643,6 +1999,64 @@ void WallpaperPreview::loadWorkshopDataBatch()
     }
 }
 
+void WallpaperPreview::prefetchAdjacentPages()
+{
+    if (m_virtualizedGrid || m_filteredWallpapers.isEmpty()) {
+        return;
+    }
+    
+    // Stay within a share of the thumbnail cache so prefetching never evicts the visible page
+    const QSize tileSize(WallpaperPreviewItem::PREVIEW_WIDTH, WallpaperPreviewItem::PREVIEW_HEIGHT);
+    const qreal ratio = devicePixelRatioF();
+    const QSize tilePixels = ThumbnailLoader::pixelSize(tileSize, ratio);
+    const qint64 pageBytes = qint64(ITEMS_PER_PAGE) * tilePixels.width() * tilePixels.height() * 4;
+    const int pageBudget = int(ThumbnailCache::instance().budgetBytes() / PREFETCH_CACHE_SHARE / pageBytes);
+    
+    // Forward paging is the common case, so the next page goes first
+    QList<int> pages;
+    if (m_currentPage + 1 < m_totalPages) {
+        pages.append(m_currentPage + 1);
+    }
+    if (m_currentPage > 0) {
+        pages.append(m_currentPage - 1);
+    }
+    
+    ThumbnailLoader& loader = ThumbnailLoader::instance();
+    int queued = 0;
+    for (int i = 0; i < pages.size() && i < pageBudget; ++i) {
+        int startIndex = pages[i] * ITEMS_PER_PAGE;
+        int endIndex = qMin(startIndex + ITEMS_PER_PAGE, m_filteredWallpapers.size());
+        for (int index = startIndex; index < endIndex; ++index) {
+            const WallpaperInfoPtr& wallpaper = m_filteredWallpapers[index];
+            // Animated previews are played by PreviewAnimator and do not use the thumbnail
+            QString lowerPath = wallpaper->previewPath.toLower();
+            if (lowerPath.isEmpty() || lowerPath.endsWith(".gif") || lowerPath.endsWith(".webp")) {
+                continue;
+            }
+            quint64 ticket = loader.request(wallpaper->id, wallpaper->previewPath, tileSize, ratio, this,
+                                            ThumbnailLoader::Callback(), ThumbnailLoader::LowPriority);
+            if (ticket != 0) {
+                m_prefetchTickets.append(ticket);
+                queued++;
+            }
+        }
+    }
+    
+    qCDebug(wallpaperPreview) << "Prefetching" << queued << "thumbnails for" << qMin(int(pages.size()), pageBudget)
+                              << "neighbouring pages";
+}
+
+void WallpaperPreview::cancelPrefetch()
+{
+    m_prefetchTimer->stop();
+    
+    ThumbnailLoader& loader = ThumbnailLoader::instance();
+    for (quint64 ticket : std::as_const(m_prefetchTickets)) {
+        loader.cancel(ticket);
+    }
+    m_prefetchTickets.clear();
+}
+
 void WallpaperPreview::refreshWallpapers()
 {
     if (m_wallpaperManager) {
@@ -1652,6 +2066,19 @@ void WallpaperPreview::refreshWallpapers()
 
 void WallpaperPreview::selectWallpaper(const QString& wallpaperId)
 {
+    if (m_virtualizedGrid) {
+        // Selecting through the selection model does not emit pressed(), so no signal loop
+        int row = m_gridModel->rowOf(wallpaperId);
+        if (row < 0) {
+            qCDebug(wallpaperPreview) << "Wallpaper not found in current view (may be filtered out):" << wallpaperId;
+            return;
+        }
+        QModelIndex index = m_gridModel->index(row);
+        m_gridView->selectionModel()->setCurrentIndex(index, QItemSelectionModel::ClearAndSelect);
+        m_gridView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+        return;
+    }
+    
     // First, try to find the wallpaper on the current page
     for (WallpaperPreviewItem* item : m_currentPageItems) {
         if (item && item->wallpaperInfo().id == wallpaperId) {
@@ -1671,9 +2098,9 @@ void WallpaperPreview::selectWallpaper(const QString& wallpaperId)
     
     // If not found on current page, search through all filtered wallpapers
     // and navigate to the correct page
-    QList<WallpaperInfo> allFiltered = getFilteredWallpapers();
+    QList<WallpaperInfoPtr> allFiltered = getFilteredWallpapers();
     for (int i = 0; i < allFiltered.size(); ++i) {
-        if (allFiltered[i].id == wallpaperId) {
+        if (allFiltered[i]->id == wallpaperId) {
             // Found the wallpaper, calculate which page it's on
             int targetPage = i / ITEMS_PER_PAGE;
             
@@ -1717,11 +2144,16 @@ void WallpaperPreview::updateTheme()
             item->updateStyle();
         }
     }
+    m_gridView->viewport()->update();
     update();
 }
 
 WallpaperInfo WallpaperPreview::getSelectedWallpaper() const
 {
+    if (m_virtualizedGrid) {
+        WallpaperInfoPtr wallpaper = m_gridModel->wallpaperAt(m_gridView->selectionModel()->currentIndex().row());
+        return wallpaper ? *wallpaper : WallpaperInfo();
+    }
     if (m_selectedItem) {
         return m_selectedItem->wallpaperInfo();
     }
@@ -1730,6 +2162,10 @@ WallpaperInfo WallpaperPreview::getSelectedWallpaper() const
 
 QString WallpaperPreview::getSelectedWallpaperId() const
 {
+    if (m_virtualizedGrid) {
+        WallpaperInfoPtr wallpaper = m_gridModel->wallpaperAt(m_gridView->selectionModel()->currentIndex().row());
+        return wallpaper ? wallpaper->id : QString();
+    }
     if (m_selectedItem) {
         return m_selectedItem->wallpaperInfo().id;
     }
@@ -1836,37 +2272,17 @@ void WallpaperPreview::stopAllPreviewAnimations()
 {
     qCDebug(wallpaperPreview) << "Stopping all wallpaper preview animations to save CPU when minimized";
     
-    // Stop animations in all wallpaper preview items
-    for (int row = 0; row < m_gridLayout->rowCount(); ++row) {
-        for (int col = 0; col < m_gridLayout->columnCount(); ++col) {
-            QLayoutItem* layoutItem = m_gridLayout->itemAtPosition(row, col);
-            if (layoutItem && layoutItem->widget()) {
-                WallpaperPreviewItem* item = qobject_cast<WallpaperPreviewItem*>(layoutItem->widget());
-                if (item && item->isAnimationPlaying()) {
-                    item->stopAnimation();
-                }
-            }
-        }
-    }
+    m_animationsSuspended = true;
+    m_animationTimer->stop();
+    stopCurrentPageAnimations();
 }
 
 void WallpaperPreview::startAllPreviewAnimations()
 {
     qCDebug(wallpaperPreview) << "Starting wallpaper preview animations when window becomes active";
     
-    // Start animations in all wallpaper preview items that have animated previews
-    for (int row = 0; row < m_gridLayout->rowCount(); ++row) {
-        for (int col = 0; col < m_gridLayout->columnCount(); ++col) {
-            QLayoutItem* layoutItem = m_gridLayout->itemAtPosition(row, col);
-            if (layoutItem && layoutItem->widget()) {
-                WallpaperPreviewItem* item = qobject_cast<WallpaperPreviewItem*>(layoutItem->widget());
-                if (item && item->hasAnimatedPreview() && !item->isAnimationPlaying()) {
-                    // Re-trigger animation loading (this will start it automatically)
-                    item->loadAnimatedPreview();
-                }
-            }
-        }
-    }
+    m_animationsSuspended = false;
+    updateVisibleAnimations();
 }
 
 void WallpaperPreview::toggleWallpaperHidden(const WallpaperInfo& wallpaper, bool hidden)
@@ -1932,5 +2348,68 @@ void WallpaperPreview::setApplyButtonEnabled(bool enabled)
     }
 }
 
+void WallpaperPreview::setVirtualizedGridEnabled(bool enabled)
+{
+    if (m_virtualizedGrid == enabled) {
+        return;
+    }
+    
+    qCDebug(wallpaperPreview) << "Switching wallpaper grid to" << (enabled ? "virtualized" : "paged") << "mode";
+    QString selectedId = getSelectedWallpaperId();
+    
+    m_virtualizedGrid = enabled;
+    ConfigManager::instance().setVirtualizedGridEnabled(enabled);
+    
+    // Leave nothing of the other mode alive: no page widgets, no model rows or pending decodes
+    clearCurrentPage();
+    m_gridModel->setWallpapers(QList<WallpaperInfoPtr>());
+    m_scrollArea->setVisible(!enabled);
+    m_gridView->setVisible(enabled);
+    
+    m_currentPage = 0;
+    updateWallpaperGrid();
+    if (!selectedId.isEmpty()) {
+        selectWallpaper(selectedId);
+    }
+}
+
+void WallpaperPreview::onGridViewScrolled()
+{
+    // Rows flung past before their decode started are not worth decoding any more
+    const QSize cell = m_gridView->gridSize();
+    const QSize viewport = m_gridView->viewport()->size();
+    if (cell.isEmpty() || viewport.isEmpty()) {
+        return;
+    }
+    
+    int columns = qMax(1, viewport.width() / cell.width());
+    int scrollY = m_gridView->verticalScrollBar()->value();
+    // One row of slack either side for the view's margins
+    int firstRow = qMax(0, scrollY / cell.height() - 1) * columns;
+    int lastRow = ((scrollY + viewport.height()) / cell.height() + 2) * columns - 1;
+    m_gridModel->retainThumbnails(firstRow, lastRow);
+}
+
+void WallpaperPreview::showGridContextMenu(const QPoint& pos)
+{
+    WallpaperInfoPtr wallpaper = m_gridModel->wallpaperAt(m_gridView->indexAt(pos).row());
+    if (!wallpaper) {
+        return;
+    }
+    
+    // Same menu as WallpaperPreviewItem::contextMenuEvent
+    QMenu contextMenu(this);
+    bool isHidden = isWallpaperHidden(wallpaper->id);
+    QAction* toggleHiddenAction = contextMenu.addAction(
+        isHidden ? "Show Wallpaper" : "Hide Wallpaper"
+    );
+    toggleHiddenAction->setIcon(QIcon(isHidden ? ":/icons/icons/show.png" : ":/icons/icons/hide.png"));
+    
+    QAction* selectedAction = contextMenu.exec(m_gridView->viewport()->mapToGlobal(pos));
+    if (selectedAction == toggleHiddenAction) {
+        toggleWallpaperHidden(*wallpaper, !isHidden);
+    }
+}
+
 // include the moc output for WallpaperPreview.h so staticMetaObject, vtables, signals, etc. are available
 #include "moc_WallpaperPreview.cpp"
\ No newline at end of file
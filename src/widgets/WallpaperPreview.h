@@ -16,13 +16,15 @@
 #include <QLoggingCategory>
 #include <QString>
 #include <QResizeEvent>
+#include <QShowEvent>
+#include <QHideEvent>
 #include <QMouseEvent>
 #include <QPaintEvent>
 #include <QDir>
 #include <QFileInfo>
 #include <QStandardPaths>
 #include <QFontMetrics>
-#include <QMovie>
+#include <QStaticText>
 #include <QTextOption>
 #include <QStyleOption>
 #include <QPainter>
@@ -32,7 +34,11 @@
 #include <QAction>
 #include <QContextMenuEvent>
 #include <QSet>
+#include <QListView>
 #include "../core/WallpaperManager.h"
+#include "../core/WallpaperSearchIndex.h"
+
+class WallpaperGridModel;
 
 Q_DECLARE_LOGGING_CATEGORY(wallpaperPreview)
 
@@ -49,6 +55,7 @@ public:
     explicit WallpaperPreviewItem(const WallpaperInfo& wallpaper, QWidget* parent = nullptr);
     
     const WallpaperInfo& wallpaperInfo() const { return m_wallpaper; }
+    void updateWallpaperInfo(const WallpaperInfo& wallpaper, WallpaperInfo::Fields changed);
     void setSelected(bool selected);
     bool isSelected() const { return m_selected; }
     void updateStyle();
@@ -57,6 +64,8 @@ public:
     
     // Add method to cancel any pending operations
     void cancelPendingOperations() { m_workshopDataCancelled = true; }
+    // Drops unfinished preview decodes and the tile's animation; used when the tile is discarded
+    void cancelPreviewLoading();
     bool isCancelled() const { return m_workshopDataCancelled; }
     
     // Animation methods - made public
@@ -93,6 +102,8 @@ protected:
 private:
     void setupUI();
     void loadPreviewImage();
+    void loadStaticPreview();
+    void releaseAnimation();
     void loadWorkshopData();
     void fetchWorkshopInfoHTTP(const QString& workshopId);
     void parseWorkshopDataFromJson(const QJsonObject& response, const QString& workshopId);
@@ -112,8 +123,20 @@ private:
     QPixmap scalePreviewKeepAspectRatio(const QPixmap& original);
     QSize calculateFitSize(const QSize& imageSize, const QSize& containerSize);
     void updateTextLayout();
-    void drawTextWithWordWrap(QPainter& painter, const QString& text, const QRect& rect, 
+    // Wrapped lines of one text block, laid out once and redrawn until the text, font or size changes
+    struct WrappedText {
+        QString text;
+        QFont font;
+        QSize size;
+        Qt::Alignment alignment;
+        QList<QStaticText> lines;
+        QList<QPoint> offsets;  // Top-left of each line, relative to the block
+    };
+    
+    void drawTextWithWordWrap(QPainter& painter, WrappedText& cache, const QString& text, const QRect& rect, 
                              const QFont& font, const QColor& color, Qt::Alignment alignment = Qt::AlignLeft);
+    static void layoutWrappedText(WrappedText& cache, const QString& text, const QSize& size,
+                                  const QFont& font, Qt::Alignment alignment);
     
     // Enhanced workshop data methods - updated for Steam API
     void parseWorkshopDataFromFilesystem();
@@ -138,8 +161,12 @@ private:
     bool m_selected;
     bool m_workshopDataLoaded;
     static QNetworkAccessManager* s_networkManager;
-    QMovie* m_previewMovie;
     QPixmap m_scaledPreview;
+    WrappedText m_nameText;
+    WrappedText m_infoText;
+    quint64 m_thumbnailTicket;  // Pending ThumbnailLoader request, 0 if none
+    qreal m_requestedRatio;     // Device pixel ratio of the last static preview request, 0 if none
+    quint64 m_animationHandle;  // PreviewAnimator handle for animated previews, 0 if none
     bool m_useCustomPainting; // Flag to use custom text rendering
 
     // Add cancellation flag
@@ -178,6 +205,11 @@ public:
     // Multi-monitor mode control
     void setDoubleClickEnabled(bool enabled);
     void setApplyButtonEnabled(bool enabled);
+    
+    // Virtualized grid: one scrolling QListView over the whole filtered library instead of
+    // a page of WallpaperPreviewItem widgets
+    void setVirtualizedGridEnabled(bool enabled);
+    bool isVirtualizedGridEnabled() const { return m_virtualizedGrid; }
 
     // Dynamic layout constants
     static constexpr int ITEMS_PER_PAGE = 20;
@@ -192,6 +224,14 @@ public:
     // Workshop batch processing constants
     static constexpr int WORKSHOP_BATCH_SIZE = 3; // Reduced for better performance
     static constexpr int WORKSHOP_BATCH_DELAY = 200; // Increased delay
+    
+    // Neighbouring page prefetch
+    static constexpr int PREFETCH_DELAY_MS = 400; // Let the visible page's decodes go first
+    static constexpr int PREFETCH_CACHE_SHARE = 2; // Prefetch may fill at most 1/N of the thumbnail cache
+    
+    // Animated previews play only while their tile is inside the scroll viewport
+    static constexpr int ANIMATION_START_DELAY_MS = 200; // Let a new page settle first
+    static constexpr int ANIMATION_UPDATE_DELAY_MS = 100; // Coalesces scroll and resize bursts
 
 signals:
     void wallpaperSelected(const WallpaperInfo& wallpaper);
@@ -200,9 +240,13 @@ signals:
 
 protected:
     void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 
 private slots:
     void onWallpapersChanged();
+    void onWallpapersAddedOrRemoved(const QStringList& ids);
+    void onWallpaperUpdated(const QString& id, WallpaperInfo::Fields changed);
     void onSearchTextChanged(const QString& text);
     void onFilterChanged();
     void onRefreshClicked();
@@ -213,18 +257,26 @@ private slots:
     void onNextPage();
     void onPageChanged();
     void loadWorkshopDataBatch();
+    void prefetchAdjacentPages();
+    void onGridViewScrolled();
+    void showGridContextMenu(const QPoint& pos);
+    void updateVisibleAnimations();
+    void onScreenChanged();
 
 private:
     void setupUI();
     void updateWallpaperGrid();
+    bool reconcileCurrentPage();
     void setupPagination();
     void updatePageInfo();
     void loadCurrentPage();
     void clearCurrentPage();
-    QList<WallpaperInfo> getFilteredWallpapers() const;
+    QList<WallpaperInfoPtr> getFilteredWallpapers() const;
+    void rebuildSearchIndex();
     void clearSelection();
     void startWallpaperDataLoading();
     void processNextWorkshopBatch();
+    void cancelPrefetch();
     
     // Enhanced responsive layout methods
     int calculateItemsPerRow() const;
@@ -254,6 +306,11 @@ private:
     QWidget* m_gridWidget;
     QGridLayout* m_gridLayout;
     
+    // Virtualized grid mode
+    QListView* m_gridView;
+    WallpaperGridModel* m_gridModel;
+    bool m_virtualizedGrid;
+    
     // Pagination UI
     QWidget* m_paginationWidget;
     QPushButton* m_prevPageButton;
@@ -261,7 +318,7 @@ private:
     QLabel* m_pageInfoLabel;
     
     // Pagination state
-    QList<WallpaperInfo> m_filteredWallpapers;
+    QList<WallpaperInfoPtr> m_filteredWallpapers;
     QList<WallpaperPreviewItem*> m_currentPageItems;
     WallpaperPreviewItem* m_selectedItem;
     int m_currentPage;
@@ -274,6 +331,14 @@ private:
     QList<WallpaperPreviewItem*> m_pendingWorkshopItems;
     int m_workshopBatchIndex;
     
+    // Thumbnails of the previous/next page, decoded into ThumbnailCache ahead of time
+    QTimer* m_prefetchTimer;
+    QList<quint64> m_prefetchTickets;
+    
+    // Visibility-driven preview animation
+    QTimer* m_animationTimer;
+    bool m_animationsSuspended;  // Window minimized or hidden to the tray
+    
     // Responsive layout
     int m_currentItemsPerRow;
     int m_lastContainerWidth;
@@ -283,6 +348,9 @@ private:
     QSet<QString> m_hiddenWallpapers;
     bool m_showHiddenWallpapers;
     
+    // Search over the library, rebuilt on a reset and patched on incremental updates
+    WallpaperSearchIndex m_searchIndex;
+    
     // Multi-monitor mode control
     bool m_doubleClickEnabled;
     
@@ -300,7 +368,7 @@ private:
     void scrollToItem(WallpaperPreviewItem* item);
     
     // Animation management methods
-    void startCurrentPageAnimations();
+    void scheduleAnimationUpdate(int delayMs = ANIMATION_UPDATE_DELAY_MS);
     void stopCurrentPageAnimations();
 };
 